@@ -2,6 +2,17 @@ from subprocess import Popen, PIPE, call
 import os
 import itertools
 import csv
+import tempfile
+
+# Run ./ensemble with the argument list cmd, exiting if it fails
+def RunEnsemble(cmd):
+    p = Popen(cmd, stdout=PIPE, stderr=PIPE)
+    stdout, stderr = p.communicate()
+    if p.returncode != 0:
+        print("'{}' failed with exit status {}:".format(" ".join(cmd), p.returncode))
+        output = (stdout + stderr).decode(errors="replace").splitlines()
+        print("\n".join(output[-5:]))
+        exit(-1)
 
 def CreateProgramFiles(pop_path, gp_path):
     if not os.path.isdir(pop_path):
@@ -59,65 +70,61 @@ if __name__ == '__main__':
     csv_writer = csv.writer(csv_out, delimiter=',')
     csv_writer.writerow(data_labels)
 
-    combinations = itertools.combinations(treatments, 2)
-    combo_num = 1
-    total_data = {}
-    for t in treatments:
-        total_data[t] = [0, 0, 0]
-
+    # Pair every file of every treatment pair in one manifest and play them all in one run.
+    # The manifest and games go in a directory of their own, so runs never read each other's games.
+    run_dir = tempfile.TemporaryDirectory(prefix="compete_")
+    manifest_path = os.path.join(run_dir.name, "compete_manifest.txt")
+    games_path = os.path.join(run_dir.name, "compete_games.csv")
+    combinations = list(itertools.combinations(treatments, 2))
+    manifest_matchups = []
+    manifest = open(manifest_path, "w")
     for combo in combinations:
-    
-        compete_type = 0
         path_1 = combo[0]
         path_2 = combo[1]
-        data = [0, 0, 0, 0, 0, 0]
-        seed = 1234
-
-        if path_1.split('_')[0] == "REP0":
-            if path_2.split('_')[0] == "REP0":
-                compete_type = 0
-            else:
-                compete_type = 1
-        else:
-            compete_type = 2 
-        
-        path_1_files = os.listdir(gp_path + path_1)
-        path_2_files = os.listdir(gp_path + path_2)
-        path_1_files = sorted(path_1_files)
-        path_2_files = sorted(path_2_files)
-        count = 0
+        type_1 = "individual" if path_1.split('_')[0] == "REP0" else "ensemble"
+        type_2 = "individual" if path_2.split('_')[0] == "REP0" else "ensemble"
+        path_1_files = sorted(os.listdir(gp_path + path_1))
+        path_2_files = sorted(os.listdir(gp_path + path_2))
         for file_1 in path_1_files:
             for file_2 in path_2_files:
                 p1 = gp_path + path_1 + "/" + file_1
                 p2 = gp_path + path_2 + "/" + file_2
-                cmd = './ensemble -RANDOM_SEED {} -COMPETE 1 -COMPETE_TYPE {} -COMPETE_FPATH_1 {} -COMPETE_FPATH_2 {}'.format(seed, compete_type, p1, p2)
-                seed += 1
-                cmd = cmd.split()
-                p = Popen(cmd, stdout=PIPE, stderr=PIPE)
-                stdout, stderr = p.communicate(input=str)
-                output = str(stdout).split('!')[1].replace("\\n'", "").replace("\\n", "")
-                output = output.split(" ")
-                # if int(output[2]) == 1:
-                #     print("Start Player:", output[4]," End Player:", output[3], "P1:", file_1, "P2:", file_2)
-                count += 1
-                data[5] += int(output[4])
-                if int(output[2]) == 1:
-                    if int(output[3]) == 0: data[3] += 1
-                    elif int(output[3]) == 1: data[4] += 1
-                    else: print("ER", int(output[3]) == 0)
-                if int(output[0]) > int(output[1]): 
-                    data[0] += 1
-                elif int(output[0]) < int(output[1]): 
-                    data[1] += 1
-                elif int(output[0]) == int(output[1]): 
-                    data[2] += 1
-                else:
-                    print("ERROR")
-                        
-        print("({}/{})".format(combo_num, "28"), path_1 + " Wins:",data[0], path_2 + " Wins:", data[1], " Ties:", data[2], end=" ")
+                manifest.write("{} {} {} {}\n".format(type_1, p1, type_2, p2))
+                manifest_matchups.append(combo)
+    manifest.close()
+
+    cmd = './ensemble -RANDOM_SEED 1234 -COMPETE 1 -EVAL_THREADS 0 -COMPETE_MANIFEST {} -COMPETE_OUTPUT {}'.format(manifest_path, games_path)
+    RunEnsemble(cmd.split())
+
+    combo_data = {}
+    for combo in combinations:
+        combo_data[combo] = [0, 0, 0, 0, 0, 0]
+    with open(games_path, "r") as games_in:
+        for game in csv.DictReader(games_in):
+            data = combo_data[manifest_matchups[int(game["match"])]]
+            data[5] += int(game["start_player"])
+            if int(game["invalid"]) == 1:
+                if int(game["curr_player"]) == 0: data[3] += 1
+                elif int(game["curr_player"]) == 1: data[4] += 1
+            if float(game["score_1"]) > float(game["score_2"]):
+                data[0] += 1
+            elif float(game["score_1"]) < float(game["score_2"]):
+                data[1] += 1
+            else:
+                data[2] += 1
+    run_dir.cleanup()
+
+    total_data = {}
+    for t in treatments:
+        total_data[t] = [0, 0, 0]
+
+    for combo_num, combo in enumerate(combinations, 1):
+        path_1 = combo[0]
+        path_2 = combo[1]
+        data = combo_data[combo]
+        print("({}/{})".format(combo_num, len(combinations)), path_1 + " Wins:",data[0], path_2 + " Wins:", data[1], " Ties:", data[2], end=" ")
         print(path_1 + " Inv.:", data[3], path_2 + " Inv.:", data[4], " P2 Went First:", data[5])
         
-        combo_num += 1
         csv_writer.writerow([path_1 + ";" + path_2] + data)
         total_data[path_1][0] += data[0]
         total_data[path_1][1] += data[2]
@@ -2,6 +2,17 @@ from subprocess import Popen, PIPE, call
 import argparse
 import csv
 import os
+import tempfile
+
+# Run ./ensemble with the argument list cmd, exiting if it fails
+def RunEnsemble(cmd):
+    p = Popen(cmd, stdout=PIPE, stderr=PIPE)
+    stdout, stderr = p.communicate()
+    if p.returncode != 0:
+        print("'{}' failed with exit status {}:".format(" ".join(cmd), p.returncode))
+        output = (stdout + stderr).decode(errors="replace").splitlines()
+        print("\n".join(output[-5:]))
+        exit(-1)
 
 def ParserConfig(parser):
     parser.add_argument('t_path', type=str, help="Path to competing treatment.")
@@ -10,8 +21,13 @@ def ParserConfig(parser):
     parser.add_argument('--agent_ko', type=int, default=-1, help="Which agent to knockout (default: none)")
     parser.add_argument('--agent_ko_all', type=bool, default=0, help="Should we do all agent knockouts?")
     parser.add_argument('--inst_ko', type=int, default=0, help="Which instruction to knockout (default: none)")
+    parser.add_argument('--ko_matrix', type=bool, default=0, help="Should we play every agent and instruction knockout in one run?")
+    parser.add_argument('--openings', type=int, default=0, help="How many random moves open each pair of games? (default: none)")
     parser.add_argument('--rep', type=int, default=-1, help="Focus on which replicate number? (default: all replicates)")
     parser.add_argument('--timeout', type=float, default=1.0, help="How many seconds to give Minimax AI to find a move?")
+    parser.add_argument('--ai_nodes', type=int, default=0, help="Nodes Minimax AI searches per move instead of using the timeout (default: timeout)")
+    parser.add_argument('--ai_depth', type=int, default=0, help="Plies Minimax AI searches per move instead of using the timeout (default: timeout)")
+    parser.add_argument('--ai_endgame', type=int, default=0, help="Empty squares at which Minimax AI starts solving the game exactly (default: never)")
 
 def GetReplicates(treatment, main_path):
     all_replicates = os.listdir(main_path)
@@ -30,17 +46,19 @@ def GetDefaultOptions():
     default_options["CD"] = 0
     return default_options
 
-def GetCommand(replicate, path, args):
+def GetOptions(replicate):
     options = GetDefaultOptions()
     new_options = replicate.split("_")[:-1]
-    seed = replicate.split("_")[-1]
-
-    agent_path = path + replicate + "/pop_{}/pop_{}.pop".format(args.gen, args.gen)
 
     for opt in new_options:
         setting = int(opt[-1])
         setting_name = opt[:-1]
         options[setting_name] = setting
+    return options
+
+def GetCommand(replicate, path, args):
+    options = GetOptions(replicate)
+    agent_path = path + replicate + "/pop_{}/pop_{}.pop".format(args.gen, args.gen)
 
     command = "./ensemble -COMPETE 1 -REPRESENTATION {} -SELECTION_METHOD {} -MULTIVOTE {} \
     -CONFIDENCE {} -COMMUNICATION {} -PENALTY {} -COORDINATOR {} \
@@ -52,14 +70,15 @@ def GetCommand(replicate, path, args):
         command += " -AGENT_KO {}".format(args.agent_ko)
     if args.inst_ko > 0:
         command += " -INST_KO {}".format(args.inst_ko)
+    if args.ai_nodes > 0:
+        command += " -AI_NODE_LIMIT {}".format(args.ai_nodes)
+    if args.ai_depth > 0:
+        command += " -AI_DEPTH_LIMIT {}".format(args.ai_depth)
+    if args.ai_endgame > 0:
+        command += " -AI_ENDGAME_EMPTIES {}".format(args.ai_endgame)
 
     return command
 
-def GetResults(raw_data):
-    raw_results = raw_data.split("\n")[-2]
-    results = raw_results.split()
-    return [int(x) for x in results]
-
 class ResultsTable:
     def __init__(self, args):
         self.wins = 0
@@ -104,18 +123,46 @@ class ResultsTable:
 def PlayGames(replicate, path, args):
     command = GetCommand(replicate, path, args)
     rep_results = ResultsTable(args)
-    
-    for i in range(args.num_games):
-        cmd = command + " -RANDOM_SEED {}".format(i + 1)
-        cmd = cmd.split()
-        p = Popen(cmd, stdout=PIPE, stderr=PIPE)
-        stdout, stderr = p.communicate(input=str)
-        stdout = stdout.decode('ascii')
-        results = GetResults(stdout)
-        rep_results.AddResults(results)
+
+    # Play every game in one run, alternating colors (a single game goes through a manifest).
+    # The manifest and games go in a directory of their own, so jobs sharing a directory don't collide.
+    run_dir = tempfile.TemporaryDirectory(prefix="compete_ai_")
+    games_path = os.path.join(run_dir.name, "compete_ai_games.csv")
+    if args.num_games > 1:
+        cmd = command + " -NUM_COMPETE_GAMES {} -COMPETE_OPENING_MOVES {}".format(args.num_games, args.openings)
+    else:
+        agent_type = "individual" if GetOptions(replicate)["REP"] == 0 else "ensemble"
+        agent_path = path + replicate + "/pop_{}/pop_{}.pop".format(args.gen, args.gen)
+        manifest_path = os.path.join(run_dir.name, "compete_ai_manifest.txt")
+        manifest = open(manifest_path, "w")
+        manifest.write("{} {} ai\n".format(agent_type, agent_path))
+        manifest.close()
+        cmd = command + " -COMPETE_MANIFEST {}".format(manifest_path)
+
+    cmd += " -RANDOM_SEED 1 -EVAL_THREADS 0 -COMPETE_OUTPUT {}".format(games_path)
+    RunEnsemble(cmd.split())
+
+    with open(games_path, "r") as games_in:
+        for game in csv.DictReader(games_in):
+            rep_results.AddResults([int(float(game["score_1"])), int(float(game["score_2"])), int(game["invalid"]),
+                                    int(game["curr_player"]), int(game["start_player"])])
+    run_dir.cleanup()
     
     return rep_results
 
+def PlayKnockoutMatrix(replicate, path, args, csv_writer):
+    command = GetCommand(replicate, path, args)
+    run_dir = tempfile.TemporaryDirectory(prefix="compete_ai_ko_")
+    matrix_path = os.path.join(run_dir.name, "compete_ai_ko.csv")
+    cmd = command + " -RANDOM_SEED 1 -EVAL_THREADS 0 -COMPETE_KO_MATRIX {} -COMPETE_KO_GAMES {}".format(matrix_path, args.num_games)
+    RunEnsemble(cmd.split())
+
+    with open(matrix_path, "r") as ko_in:
+        for variant in csv.DictReader(ko_in):
+            csv_writer.writerow([variant["wins"], variant["losses"], variant["ties"], variant["invalid"], variant["average_score"],
+                                 variant["agent_ko"], variant["inst_ko"], args.timeout, variant["games"]])
+    run_dir.cleanup()
+
 def WriteCSV(csv_writer, results, args):
     data = results.GetData()
     data = data + [args.agent_ko, args.inst_ko, args.timeout, args.num_games]
@@ -144,7 +191,9 @@ if __name__ == "__main__":
 
     for replicate in rep_list:
         print("Treatment: {}".format(replicate))
-        if args.agent_ko_all:
+        if args.ko_matrix:
+            PlayKnockoutMatrix(replicate, main_path, args, csv_writer)
+        elif args.agent_ko_all:
             for i in range(GROUP_SIZE + 1):
                 args.agent_ko = i - 1
                 print("Knocking out agent", args.agent_ko)
@@ -18,6 +18,50 @@ using namespace std;
 const int iterateModes[4] = {1, 2, 3, 4};
 const int iterateDirections[2] = {-1, 1};
 
+#define NOTFILE0 0xfefefefefefefefeULL //every square except x == 0
+#define NOTFILE7 0x7f7f7f7f7f7f7f7fULL //every square except x == BOARDSIZE-1
+
+
+//uint64_t shift(uint64_t bits, int direction)
+//  moves every square in bits one step in one of the 8 compass
+//  directions (0 = up, clockwise), dropping squares that leave the board
+static uint64_t shift(uint64_t bits, int direction){
+    switch(direction){
+        case(0): return bits >> 8;
+        case(1): return (bits >> 7) & NOTFILE0;
+        case(2): return (bits << 1) & NOTFILE0;
+        case(3): return (bits << 9) & NOTFILE0;
+        case(4): return bits << 8;
+        case(5): return (bits << 7) & NOTFILE7;
+        case(6): return (bits >> 1) & NOTFILE7;
+        case(7): return (bits >> 9) & NOTFILE7;
+        default: return 0;
+    }
+}
+
+//ZobristKeys
+//  Zobrist keys, one per (player, square) plus
+//  keys[WHITE][NUMSQUARES] for white to move
+class ZobristKeys{
+public:
+    ZobristKeys(){
+        uint64_t seed = 0x2545f4914f6cdd1dULL;
+        for(int p = 0; p < 3; p++){
+            for(int i = 0; i <= NUMSQUARES; i++){
+                //splitmix64
+                uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                keys[p][i] = z ^ (z >> 31);
+            }
+        }
+    }
+    uint64_t keys[3][NUMSQUARES+1];
+};
+
+static const ZobristKeys zobrist;
+
+
 //Board::Square::Square()
 //  empty Square constructor
 Board::Square::Square(){}
@@ -42,42 +86,80 @@ Board::Move::Move(char y, char x){
     this->square.y = y;
     this->square.x = x;
     this->valid = false;
+    this->flips = 0;
 }
 
 
-//Board::Board()
-//  constructor to initialize new game board
-Board::Board(){
-    //initialize empty board
-    for(int i = 0; i < BOARDSIZE; i++){
-        for(int j = 0; j < BOARDSIZE; j++){
-            board[i][j] = 0;
+//Board::MoveList::MoveList()
+//  empty fixed capacity move list
+Board::MoveList::MoveList(){
+    count = 0;
+}
+
+
+//int Board::MoveList::size()
+//  number of moves in the list
+int Board::MoveList::size() const{
+    return count;
+}
+
+
+//Board::Move &Board::MoveList::operator[](int i)
+//  access the ith move in the list
+Board::Move &Board::MoveList::operator[](int i){
+    return moves[i];
+}
+
+
+//void Board::MoveList::push_back(const Board::Move &move)
+//  append a move to the list
+void Board::MoveList::push_back(const Board::Move &move){
+    moves[count++] = move;
+}
+
+
+//void Board::MoveList::MoveToFront(int square)
+//  move the move on square (y*BOARDSIZE+x) to the front of the list,
+//  keeping the order of the others
+void Board::MoveList::MoveToFront(int square){
+    for(int i = 0; i < count; i++){
+        if(moves[i].square.y*BOARDSIZE + moves[i].square.x == square){
+            Board::Move move = moves[i];
+            for(; i > 0; i--)
+                moves[i] = moves[i-1];
+            moves[0] = move;
+            return;
         }
     }
+}
+
 
+//Board::Board()
+//  constructor to initialize new game board
+Board::Board(){
     //initialize starting pieces
-    board[4][3] = BLACK;
-    board[3][4] = BLACK;
-    board[3][3] = WHITE;
-    board[4][4] = WHITE;
+    pieces[0] = 0;
+    pieces[BLACK] = (1ULL << (4*BOARDSIZE + 3)) | (1ULL << (3*BOARDSIZE + 4));
+    pieces[WHITE] = (1ULL << (3*BOARDSIZE + 3)) | (1ULL << (4*BOARDSIZE + 4));
 
     currentPlayer = BLACK;
     playerPassed = false;
     score[BLACK] = 2;
     score[WHITE] = 2;
+    hash = ComputeHash();
 }
 
-//Board::Board(Board *board)
+//Board::Board(const Board &board)
 //  copy constructor
-Board::Board(Board &b){
-    for(int i = 0; i < BOARDSIZE; i++)
-        for(int j = 0; j < BOARDSIZE; j++)
-            this->board[i][j] = b.board[i][j];
-    for(int i = 0; i < 3; i++)
+Board::Board(const Board &b){
+    for(int i = 0; i < 3; i++){
+        this->pieces[i] = b.pieces[i];
         this->score[i] = b.score[i];
+    }
 
     this->currentPlayer = b.currentPlayer;
     this->playerPassed = b.playerPassed;
+    this->hash = b.hash;
 }
 
 
@@ -86,17 +168,23 @@ Board::Board(Board &b){
 Board::Board(char boardState[8][8], int currentPlayer){
     score[BLACK] = 0;
     score[WHITE] = 0;
+    for(int i = 0; i < 3; i++)
+        pieces[i] = 0;
     for(int i = 0; i < BOARDSIZE; i++){
         for(int j = 0; j < BOARDSIZE; j++){
-            board[i][j] = boardState[i][j];
-            if(boardState[i][j] == WHITE)
+            if(boardState[i][j] == WHITE){
+                pieces[WHITE] |= 1ULL << (i*BOARDSIZE + j);
                 score[WHITE]++;
-            else if(boardState[i][j] == BLACK)
+            }
+            else if(boardState[i][j] == BLACK){
+                pieces[BLACK] |= 1ULL << (i*BOARDSIZE + j);
                 score[BLACK]++;
+            }
         }
     }
     this->currentPlayer = currentPlayer;
     playerPassed = false;
+    hash = ComputeHash();
 }
 
 
@@ -158,7 +246,7 @@ void Board::Print(vector<Board::Move> moves, bool computer){
             for(int k = 0; k < moves.size(); k++){
                 if(moves[k].square.y == i && moves[k].square.x == j){
                     if(computer)
-                        cout << GREEN << setw(2) << (int)board[i][j] << RESET << " ";
+                        cout << GREEN << setw(2) << (int)At(i, j) << RESET << " ";
                     else{
                         cout << YELLOW << setw(2) << k << RESET << " ";
                     }
@@ -166,11 +254,11 @@ void Board::Print(vector<Board::Move> moves, bool computer){
                 }
             }
             if(!potentialMove){
-                if(board[i][j] == WHITE)
+                if(At(i, j) == WHITE)
                     cout << RED << setw(2) << "W" << RESET << " ";
-                else if(board[i][j] == BLACK)
+                else if(At(i, j) == BLACK)
                     cout << BLUE << setw(2) << "B" << RESET << " ";
-                //cout << setw(2) << (int)board[i][j] << RESET << " ";
+                //cout << setw(2) << (int)At(i, j) << RESET << " ";
                 else cout << setw(2) << "-" << RESET << " ";
             }
         }
@@ -180,10 +268,40 @@ void Board::Print(vector<Board::Move> moves, bool computer){
 }
 
 
+//char Board::At(int y, int x)
+//  owner of square [y][x] (0 if open)
+char Board::At(int y, int x) const{
+    uint64_t square = 1ULL << (y*BOARDSIZE + x);
+    if(pieces[WHITE] & square)
+        return WHITE;
+    if(pieces[BLACK] & square)
+        return BLACK;
+    return 0;
+}
+
+
+//int Board::Count(uint64_t bits)
+//  number of squares set in a bitboard
+int Board::Count(uint64_t bits){
+    return __builtin_popcountll(bits);
+}
+
+
+//uint64_t Board::ComputeHash()
+//  Zobrist hash of the board from scratch
+uint64_t Board::ComputeHash() const{
+    uint64_t h = (currentPlayer == WHITE) ? zobrist.keys[WHITE][NUMSQUARES] : 0;
+    for(int p = WHITE; p <= BLACK; p++)
+        for(uint64_t bits = pieces[p]; bits; bits &= bits - 1)
+            h ^= zobrist.keys[p][__builtin_ctzll(bits)];
+    return h;
+}
+
+
 //bool Board::OnFrontier(int y, int x)
 //  checks whether a piece is on the frontier
 bool Board::OnFrontier(int y, int x){
-    if(board[y][x] == '0')
+    if(At(y, x) == '0')
         return false;
     for(int n = 0; n < NUMMODES; n++){
         int mode = iterateModes[n];
@@ -192,7 +310,7 @@ bool Board::OnFrontier(int y, int x){
             char Y = y, X = x;
             iterate(Y, X, mode, direction);
             if(onBoard(Y, X))
-                if(board[Y][X] != '0')
+                if(At(Y, X) != '0')
                     return true;
         }
     }
@@ -220,78 +338,157 @@ bool Board::NextPlayer(bool currentPlayerPass){
     currentPlayer = (currentPlayer == WHITE)
         ? BLACK
         : WHITE;
+    hash ^= zobrist.keys[WHITE][NUMSQUARES];
     playerPassed = false;
     return false;
 }
 
 
-//void Board::ApplyMove(Board::Move move)
+//void Board::ApplyMove(const Board::Move &move)
 //  method to apply a move to the board,
 //  flipping the appropriate tiles
-void Board::ApplyMove(Board::Move move){
-    board[move.square.y][move.square.x] = currentPlayer;
-    if(currentPlayer == WHITE)
-        score[WHITE]++;
-    else
-        score[BLACK]++;
+void Board::ApplyMove(const Board::Move &move){
+    int opponent = (currentPlayer == WHITE)
+        ? BLACK
+        : WHITE;
+    int flipped = Count(move.flips);
+    int square = move.square.y*BOARDSIZE + move.square.x;
+
+    pieces[currentPlayer] |= move.flips | (1ULL << square);
+    pieces[opponent] &= ~move.flips;
+    score[currentPlayer] += 1 + flipped;
+    score[opponent] -= flipped;
+
+    hash ^= zobrist.keys[currentPlayer][square];
+    for(uint64_t bits = move.flips; bits; bits &= bits - 1){
+        int i = __builtin_ctzll(bits);
+        hash ^= zobrist.keys[currentPlayer][i] ^ zobrist.keys[opponent][i];
+    }
+}
 
-    for(int i = 0; i < move.flips.size(); i++){
-        board[move.flips[i].y][move.flips[i].x] = currentPlayer;
-        if(currentPlayer == WHITE){
-            score[WHITE]++;
-            score[BLACK]--;
-        }
-        else{
-            score[BLACK]++;
-            score[WHITE]--;
+
+//Board::Undo Board::MakeMove(const Board::Move &move)
+//  apply a move and hand the turn over (ApplyMove then NextPlayer(false)),
+//  returning what UnmakeMove needs to restore the board
+Board::Undo Board::MakeMove(const Board::Move &move){
+    Undo undo;
+    undo.flips = move.flips;
+    undo.square = move.square.y*BOARDSIZE + move.square.x;
+    undo.player = currentPlayer;
+    undo.hash = hash;
+    undo.playerPassed = playerPassed;
+    ApplyMove(move);
+    NextPlayer(false);
+    return undo;
+}
+
+
+//Board::Undo Board::MakePass()
+//  pass the turn (NextPlayer(true)), returning what UnmakeMove
+//  needs to restore the board
+Board::Undo Board::MakePass(){
+    Undo undo;
+    undo.flips = 0;
+    undo.square = -1;
+    undo.player = currentPlayer;
+    undo.hash = hash;
+    undo.playerPassed = playerPassed;
+    NextPlayer(true);
+    return undo;
+}
+
+
+//void Board::UnmakeMove(const Board::Undo &undo)
+//  take back the last MakeMove or MakePass
+void Board::UnmakeMove(const Board::Undo &undo){
+    if(undo.square >= 0){
+        int opponent = (undo.player == WHITE)
+            ? BLACK
+            : WHITE;
+        int flipped = Count(undo.flips);
+        pieces[undo.player] &= ~(undo.flips | (1ULL << undo.square));
+        pieces[opponent] |= undo.flips;
+        score[undo.player] -= 1 + flipped;
+        score[opponent] += flipped;
+    }
+    currentPlayer = undo.player;
+    hash = undo.hash;
+    playerPassed = undo.playerPassed;
+}
+
+
+//uint64_t Board::flipMask(int player, int square)
+//  private method to find the pieces player would flip by playing square
+uint64_t Board::flipMask(int player, int square) const{
+    return FlipMask(pieces[player], pieces[(player == WHITE) ? BLACK : WHITE], square);
+}
+
+
+//uint64_t Board::FlipMask(uint64_t own, uint64_t opp, int square)
+//  the opp pieces flipped by playing square on a board where the
+//  mover owns own and the opponent owns opp
+uint64_t Board::FlipMask(uint64_t own, uint64_t opp, int square){
+    uint64_t flips = 0;
+
+    for(int d = 0; d < 8; d++){
+        uint64_t trace = 0; //keep track of potential flips
+        uint64_t next = shift(1ULL << square, d);
+        while(next & opp){
+            trace |= next;
+            next = shift(next, d);
         }
+        if(next & own)
+            flips |= trace;
+    }
+    return flips;
+}
+
+
+//uint64_t Board::MoveMask(int player)
+//  method to find every open square the player can legally play
+uint64_t Board::MoveMask(int player) const{
+    return MoveMask(pieces[player], pieces[(player == WHITE) ? BLACK : WHITE]);
+}
+
+
+//uint64_t Board::MoveMask(uint64_t own, uint64_t opp)
+//  every open square the owner of own can legally play against opp
+uint64_t Board::MoveMask(uint64_t own, uint64_t opp){
+    uint64_t open = ~(own | opp);
+    uint64_t moves = 0;
+
+    for(int d = 0; d < 8; d++){
+        uint64_t trace = shift(own, d) & opp;
+        for(int i = 0; i < BOARDSIZE - 3; i++)
+            trace |= shift(trace, d) & opp;
+        moves |= shift(trace, d);
+    }
+    return moves & open;
+}
+
+
+//void Board::LegalMoves(int player, Board::MoveList &moves)
+//  method to find the legal moves for the current player,
+//  in row major order, without allocating
+void Board::LegalMoves(int player, Board::MoveList &moves){
+    for(uint64_t open = MoveMask(player); open; open &= open - 1){
+        int square = __builtin_ctzll(open);
+        Board::Move move = Board::Move(square / BOARDSIZE, square % BOARDSIZE);
+        move.valid = true;
+        move.flips = flipMask(player, square);
+        moves.push_back(move);
     }
 }
 
 //vector<Board::Move> Board::LegalMoves(int player)
 //  method to find the legal moves for the current player
 vector<Board::Move> Board::LegalMoves(int player){
-    vector<Board::Move> moves;
+    Board::MoveList list;
+    LegalMoves(player, list);
 
-    for(int i = 0; i < BOARDSIZE; i++){
-        for(int j = 0; j < BOARDSIZE; j++){
-            if(board[i][j] != 0) //only open squares can be played
-                continue;
-
-            Board::Move move = Board::Move(i, j);
-
-            for(int n = 0; n < NUMMODES; n++){
-                int mode = iterateModes[n];
-                for(int m = 0; m < NUMDIRECTIONS; m++){
-                    int direction = iterateDirections[m];
-                    char y = move.square.y, x = move.square.x;
-                    vector<Board::Square> trace;
-                    
-                    iterate(y, x, mode, direction);
-
-                    //not a valid direction unless opponent's piece is next
-                    if((board[y][x] == player) || (board[y][x] == 0))
-                        continue;
-
-                    for(y, x; onBoard(y, x); iterate(y, x, mode, direction)){
-                        if(board[y][x] == player){
-                            //mark move as valid and append trace to flips vector
-                            move.valid = true;
-                            move.flips.insert(move.flips.end(), trace.begin(), trace.end());
-                            break;
-                        }
-                        else if(board[y][x] == 0)
-                            break;
-                        else{
-                            trace.push_back(Board::Square(y, x)); //keep track of potential flips
-                        }
-                    }
-                }
-            }
-            if(move.valid)
-                moves.push_back(move);
-        }
-    }
+    vector<Board::Move> moves;
+    for(int i = 0; i < list.size(); i++)
+        moves.push_back(list[i]);
     return moves;
 }
 
@@ -6,6 +6,7 @@
 #define _BOARD_H_
 
 #include <vector>
+#include <stdint.h>
 #include "const.h"
 
 using namespace std;
@@ -26,28 +27,62 @@ public:
         Move(char y, char x);
         Board::Square square;
         bool valid;
-        vector<Square> flips;
+        uint64_t flips; //bit y*BOARDSIZE+x is set for every piece the move flips
+    };
+
+    class MoveList{
+    public:
+        MoveList();
+        int size() const;
+        Board::Move &operator[](int i);
+        void push_back(const Board::Move &move);
+        void MoveToFront(int square);
+    private:
+        Board::Move moves[MAXMOVES];
+        int count;
+    };
+
+    class Undo{ //what UnmakeMove needs to take back a move or pass
+    public:
+        uint64_t flips;
+        int square; //-1 for a pass
+        int player;
+        uint64_t hash;
+        bool playerPassed;
     };
 
     Board();
-    Board(Board &b);
+    Board(const Board &b);
     Board(char boardState[8][8], int currentPlayer);
     void Print(vector<Board::Move> moves = vector<Board::Move>(), bool computer = false);
+    char At(int y, int x) const;
     bool OnFrontier(int y, int x);
     bool TerminalState(bool currentPlayerPass);
     bool NextPlayer(bool currentPlayerPass);
-    void ApplyMove(Board::Move move);
+    void ApplyMove(const Board::Move &move);
+    Board::Undo MakeMove(const Board::Move &move);
+    Board::Undo MakePass();
+    void UnmakeMove(const Board::Undo &undo);
     vector<Board::Move> LegalMoves(int player);
+    void LegalMoves(int player, Board::MoveList &moves);
+    uint64_t MoveMask(int player) const;
+    static uint64_t MoveMask(uint64_t own, uint64_t opp);
+    static uint64_t FlipMask(uint64_t own, uint64_t opp, int square);
     void GameOver();
+
+    static int Count(uint64_t bits);
+    uint64_t ComputeHash() const;
     
     int currentPlayer;
     int score[3];
-    char board[BOARDSIZE][BOARDSIZE];
+    uint64_t pieces[3]; //bit y*BOARDSIZE+x is set for every square the player owns
+    uint64_t hash;      //Zobrist hash of pieces and currentPlayer
     bool playerPassed;
 
 private:
     bool onBoard(const char y, const char x);
     bool iterate(char &y, char &x, const int mode, const int direction);
+    uint64_t flipMask(int player, int square) const;
 };
 
 #endif //_BOARD_H_
@@ -9,8 +9,19 @@
 #define NUMMODES 4
 #define NUMDIRECTIONS 2
 
+#define MAXMOVES 60 //an empty square per move at most
+
+#define CORNERMASK 0x8100000000000081ULL //squares [0][0], [0][7], [7][0], [7][7]
+#define EDGEMASK 0xff818181818181ffULL   //squares on the outer ring
+
+#define NUMQUADRANTS 4
+#define QUADRANTMASKS {0x000000000f0f0f0fULL, 0x00000000f0f0f0f0ULL, \
+                       0x0f0f0f0f00000000ULL, 0xf0f0f0f000000000ULL} //4x4 board quarters
+
 #define TIMECUTOFF 0.9
 
+#define DEFAULTTABLESIZE (1 << 20) //transposition table entries
+
 #define RESET   "\033[0m"
 #define RED     "\033[31m"
 #define GREEN   "\033[32m"
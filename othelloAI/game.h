@@ -6,8 +6,12 @@
 #define _GAME_H_
 
 #include <time.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include "board.h"
 #include "const.h"
+#include "ttable.h"
 #include "base/Ptr.h"
 #include "tools/Random.h"
 
@@ -16,31 +20,68 @@ using namespace std;
 
 class Game{
 public:
-    Game(emp::Ptr<emp::Random> rand_ptr);
+    Game(emp::Ptr<emp::Random> rand_ptr, size_t tableSize = DEFAULTTABLESIZE);
     void Setup(int gameType);
     void Play();
 
 public: // CHanged
-    int heuristic(Board board);
-    int alphabeta(Board board, int depth, int alpha, int beta, bool maxPlayer);
+    int heuristic(const Board &board);
+    int alphabeta(Board &board, int depth, int alpha, int beta, bool maxPlayer);
     Board::Move smartMove();
+    Board::Move solveEndgame();
+    int solve(uint64_t own, uint64_t opp, int alpha, int beta, bool passed);
+    void helperSearch(int id, atomic<bool> *stopFlag);
+    double elapsed();
     bool humanMove();
     bool randomMove();
 
     emp::Ptr<emp::Random> random;
+    TTable table;
+    TTable *tt; //table searched with (shared with the helpers of a parallel search)
     Board board;
     int maxPlayer;
     bool humanPlayer[3];
     double timeLimit;
+    long nodeLimit; //if > 0, search this many nodes per move instead of timing out
+    int maxDepth;   //if > 0, search this many plies per move instead of timing out
+    long nodes;     //nodes visited by the last smartMove
+    int searchDepth; //deepest iteration the last smartMove completed
+    int threads; //threads smartMove searches with (timed searches only)
+    bool wallClock; //time searches in wall time even with one thread (for processes running several games at once)
+    int endgameEmpties; //if > 0, solve positions with this many empty squares or fewer exactly
     clock_t startTime;
+    chrono::steady_clock::time_point startWall;
+    atomic<bool> *stop; //set when a helper thread should give up
     bool timeout;
 };
 
-//Game::Game()
-//  empty Game constructor
-Game::Game(emp::Ptr<emp::Random> rand_ptr)
+//Game::Game(emp::Ptr<emp::Random> rand_ptr, size_t tableSize)
+//  Game constructor, with a transposition table of up to
+//  tableSize entries (0 disables it)
+Game::Game(emp::Ptr<emp::Random> rand_ptr, size_t tableSize)
+    : table(tableSize)
 {
     random = rand_ptr;
+    tt = &table;
+    nodeLimit = 0;
+    maxDepth = 0;
+    nodes = 0;
+    searchDepth = 0;
+    threads = 1;
+    wallClock = false;
+    endgameEmpties = 0;
+    stop = NULL;
+}
+
+//double Game::elapsed()
+//  seconds since the current search started; wall time for a parallel
+//  search (or when asked for), since clock() counts the cpu time of
+//  every thread in the process
+double Game::elapsed()
+{
+    if (threads > 1 || wallClock)
+        return chrono::duration<double>(chrono::steady_clock::now() - startWall).count();
+    return ((float)(clock() - startTime)) / CLOCKS_PER_SEC;
 }
 
 //void Game::Setup(int gameType)
@@ -132,7 +173,7 @@ void Game::Setup(int gameType)
     }
 }
 
-//int Game::heuristic(Board b)
+//int Game::heuristic(const Board &b)
 //  heuristic evaluation of board state
 //  accounts for number of pieces of each color, corners,
 //  potential corners (that the opponent can capture),
@@ -141,7 +182,7 @@ void Game::Setup(int gameType)
 //  reference:
 //  Kartik Kukreja, New Delhi, India
 //  {http://kartikkukreja.wordpress.com/2013/03/30/heuristic-function-for-reversiothello/}
-int Game::heuristic(Board b)
+int Game::heuristic(const Board &b)
 {
     double piececount, corners, potentialCorners, edges, frontier, mobility;
     int mine, opp;
@@ -162,88 +203,52 @@ int Game::heuristic(Board b)
     piececount = (100.0 * b.score[maxPlayer]) / (b.score[maxPlayer] + b.score[opponent]);
 
     //corners
-    mine = 0, opp = 0;
-    if (b.board[0][0] == maxPlayer)
-        mine++;
-    else if (b.board[0][0] == opponent)
-        opp++;
-    if (b.board[0][7] == maxPlayer)
-        mine++;
-    else if (b.board[0][7] == opponent)
-        opp++;
-    if (b.board[7][0] == maxPlayer)
-        mine++;
-    else if (b.board[7][0] == opponent)
-        opp++;
-    if (b.board[7][7] == maxPlayer)
-        mine++;
-    else if (b.board[7][7] == opponent)
-        opp++;
+    mine = Board::Count(b.pieces[maxPlayer] & CORNERMASK);
+    opp = Board::Count(b.pieces[opponent] & CORNERMASK);
     corners = 25.0 * (mine - opp);
 
     //edges and frontier
-    int myEdges = 0, oppEdges = 0;
-    int myFrontier = 0, oppFrontier = 0;
-    for (int i = 0; i < BOARDSIZE; i++)
-    {
-        for (int j = 0; j < BOARDSIZE; j++)
-        {
-            if (i == 0 || i == BOARDSIZE - 1 || j == 0 || j == BOARDSIZE - 1)
-            {
-                if (b.board[i][j] == maxPlayer)
-                    myEdges++;
-                else if (b.board[i][j] == opponent)
-                    oppEdges++;
-            }
-            else if (b.board[i][j] != '0')
-            {
-                if (b.OnFrontier(i, j))
-                {
-                    if (b.board[i][j] == maxPlayer)
-                        myFrontier++;
-                    else if (b.board[i][j] == opponent)
-                        oppFrontier++;
-                }
-            }
-        }
-    }
+    //(Board::OnFrontier holds for every interior piece, so the
+    // frontier counts are the interior piece counts)
+    int myEdges = Board::Count(b.pieces[maxPlayer] & EDGEMASK);
+    int oppEdges = Board::Count(b.pieces[opponent] & EDGEMASK);
+    int myFrontier = Board::Count(b.pieces[maxPlayer] & ~EDGEMASK);
+    int oppFrontier = Board::Count(b.pieces[opponent] & ~EDGEMASK);
     edges = 100.0 * myEdges / (myEdges + oppEdges);
     frontier = -100 * (myFrontier - oppFrontier); //frontier pieces are bad!
 
     //mobility
-    vector<Board::Move> myLegal = board.LegalMoves(maxPlayer);
-    vector<Board::Move> oppLegal = board.LegalMoves(opponent);
-    mobility = 100.0 * myLegal.size() / (myLegal.size() + oppLegal.size());
+    uint64_t myLegal = board.MoveMask(maxPlayer);
+    uint64_t oppLegal = board.MoveMask(opponent);
+    mobility = 100.0 * Board::Count(myLegal) / (Board::Count(myLegal) + Board::Count(oppLegal));
 
     //potential corners (pseudo-expand node)
-    opp = 0;
-    for (int i = 0; i < oppLegal.size(); i++)
-    {
-        if (oppLegal[i].square.y == 0 && oppLegal[i].square.x == 0)
-            opp++;
-        else if (oppLegal[i].square.y == 0 && oppLegal[i].square.x == (BOARDSIZE - 1))
-            opp++;
-        else if (oppLegal[i].square.y == (BOARDSIZE - 1) && oppLegal[i].square.x == 0)
-            opp++;
-        else if (oppLegal[i].square.y == (BOARDSIZE - 1) && oppLegal[i].square.x == (BOARDSIZE - 1))
-            opp++;
-    }
+    opp = Board::Count(oppLegal & CORNERMASK);
     potentialCorners = -25.0 * opp;
 
     return pW * piececount + cW * corners + pcW * potentialCorners + eW * edges + fW * frontier + mW * mobility;
 }
 
-//int Game::alphabeta(Board board, int depth, int alpha, int beta, bool maxPlayer)
+//int Game::alphabeta(Board &board, int depth, int alpha, int beta, bool maxPlayer)
 //  alpha beta search method implementing minimax A* search
-//  with alpha beta pruning
+//  with alpha beta pruning; moves are made and unmade on board,
+//  which is left as it was passed in
 //  reference
 //  {http://aima.cs.berkeley.edu/python/games.html}
-int Game::alphabeta(Board board, int depth, int alpha, int beta, bool maxPlayer)
+int Game::alphabeta(Board &board, int depth, int alpha, int beta, bool maxPlayer)
 {
     int a = alpha, b = beta, msize;
-
-    //do a quick check on time limit and depth
-    if ((((float)(clock() - startTime)) / CLOCKS_PER_SEC) > TIMECUTOFF * timeLimit)
+    nodes++;
+
+    //do a quick check on the search budget and depth
+    bool outOfBudget;
+    if (nodeLimit > 0)
+        outOfBudget = nodes > nodeLimit;
+    else if (maxDepth > 0)
+        outOfBudget = false;
+    else
+        outOfBudget = elapsed() > TIMECUTOFF * timeLimit;
+    if (outOfBudget || (stop && stop->load(memory_order_relaxed)))
     {
         timeout = true;
         return heuristic(board);
@@ -253,22 +258,41 @@ int Game::alphabeta(Board board, int depth, int alpha, int beta, bool maxPlayer)
     else
         depth--;
 
-    vector<Board::Move> m = board.LegalMoves(board.currentPlayer); //expand
+    //reuse what earlier iterations learned about this position
+    int best = -1;
+    TTable::Entry entry;
+    if (tt->Probe(board.hash, entry))
+    {
+        if (entry.depth >= depth)
+        {
+            if (entry.bound == TT_EXACT)
+                return entry.value;
+            if (entry.bound == TT_LOWER && entry.value >= beta)
+                return entry.value;
+            if (entry.bound == TT_UPPER && entry.value <= alpha)
+                return entry.value;
+        }
+        best = entry.best;
+    }
+
+    Board::MoveList m;
+    board.LegalMoves(board.currentPlayer, m); //expand
     msize = m.size();
+    if (best >= 0)
+        m.MoveToFront(best); //search the best move found so far first
 
     if (msize == 0)
     { //no legal moves
         if (board.TerminalState(true))
         { //check terminal state
-            Board child = board;
-            child.NextPlayer(false);
-            return heuristic(child);
+            return heuristic(board);
         }
         else
         { //if pass is only move, continue search with pass
-            Board child = board;
-            child.NextPlayer(true);
-            return alphabeta(child, depth, alpha, beta, !maxPlayer);
+            Board::Undo undo = board.MakePass();
+            int eval = alphabeta(board, depth, alpha, beta, !maxPlayer);
+            board.UnmakeMove(undo);
+            return eval;
         }
     }
 
@@ -277,20 +301,26 @@ int Game::alphabeta(Board board, int depth, int alpha, int beta, bool maxPlayer)
         int v = INT_MIN;
         for (int i = 0; i < msize; i++)
         {
-            Board child = board;
-            child.ApplyMove(m[i]);
-            child.NextPlayer(false);
-
-            int eval = alphabeta(child, depth, a, b, false);
+            Board::Undo undo = board.MakeMove(m[i]);
+            int eval = alphabeta(board, depth, a, b, false);
+            board.UnmakeMove(undo);
+            if (eval > v)
+                best = m[i].square.y * BOARDSIZE + m[i].square.x;
             v = MAX(v, eval);
 
             //if opponent can make a move that will give max
             //a lower score than alpha, this branch is not
             //worth exploring
             if (v >= beta)
+            {
+                if (!timeout)
+                    tt->Store(board.hash, v, depth, TT_LOWER, best);
                 return v;
+            }
             a = MAX(a, v);
         }
+        if (!timeout)
+            tt->Store(board.hash, v, depth, (v > alpha) ? TT_EXACT : TT_UPPER, best);
         return v;
     }
     else
@@ -298,20 +328,26 @@ int Game::alphabeta(Board board, int depth, int alpha, int beta, bool maxPlayer)
         int v = INT_MAX;
         for (int i = 0; i < msize; i++)
         {
-            Board child = board;
-            child.ApplyMove(m[i]);
-            child.NextPlayer(false);
-
-            int eval = alphabeta(child, depth, a, b, true);
+            Board::Undo undo = board.MakeMove(m[i]);
+            int eval = alphabeta(board, depth, a, b, true);
+            board.UnmakeMove(undo);
+            if (eval < v)
+                best = m[i].square.y * BOARDSIZE + m[i].square.x;
             v = MIN(v, eval);
 
             //if opponent can make a move that will give max
             //a lower score than alpha, this branch is not
             //worth exploring
             if (v <= a)
+            {
+                if (!timeout)
+                    tt->Store(board.hash, v, depth, TT_UPPER, best);
                 return v;
+            }
             b = MIN(b, v);
         }
+        if (!timeout)
+            tt->Store(board.hash, v, depth, (v < beta) ? TT_EXACT : TT_LOWER, best);
         return v;
     }
 }
@@ -326,10 +362,35 @@ Board::Move Game::smartMove()
     Board::Move move, bestMove;
 
     startTime = clock();
+    startWall = chrono::steady_clock::now();
     maxPlayer = board.currentPlayer;
+    nodes = 0;
+    searchDepth = 0;
+    tt->NewSearch(); //heuristic values depend on the root board
+
+    //close to the end, play the exact result instead of the heuristic
+    if (endgameEmpties > 0 && depthLimit <= endgameEmpties && board.MoveMask(board.currentPlayer))
+        return solveEndgame();
+
+    //a node or depth budget makes the move independent of machine load
+    bool budgeted = nodeLimit > 0 || maxDepth > 0;
+    if (maxDepth > 0 && maxDepth < depthLimit)
+        depthLimit = maxDepth;
+
+    //lazy SMP: helpers search the same root at staggered depths,
+    //sharing what they find through the transposition table
+    //(not for budgeted searches, whose result would depend on thread timing)
+    atomic<bool> stopHelpers(false);
+    vector<thread> helpers;
+    for (int t = 1; !budgeted && t < threads; t++)
+        helpers.push_back(thread(&Game::helperSearch, this, t, &stopHelpers));
 
     //expand layer 1
-    vector<Board::Move> legal = board.LegalMoves(board.currentPlayer);
+    //(the search makes and unmakes moves on a copy, since the
+    // heuristic reads the root position from board)
+    Board::MoveList legal;
+    board.LegalMoves(board.currentPlayer, legal);
+    Board child = board;
 
     // if(legal.size() == 0){ //if no legal moves, pass
     //     cout << "Computer had to pass :(" << endl;
@@ -338,17 +399,16 @@ Board::Move Game::smartMove()
 
     //increment depth of search until time runs out
     //look for the move with the MAX evaluation
-    for (depth = 0; (((float)(clock() - startTime)) / CLOCKS_PER_SEC < timeLimit / 2.0) && depth < depthLimit; depth++)
+    for (depth = 0; (budgeted || elapsed() < timeLimit / 2.0) && depth < depthLimit; depth++)
     {
         int alpha = INT_MIN, beta = INT_MAX, randMove = 1;
         timeout = false; //reset timeout
 
         for (int i = 0; i < legal.size(); i++)
         { //maximize alpha
-            Board child = board;
-            child.ApplyMove(legal[i]);
-            child.NextPlayer(false);
+            Board::Undo undo = child.MakeMove(legal[i]);
             eval = alphabeta(child, depth, alpha, beta, false);
+            child.UnmakeMove(undo);
 
             //if this depth timed out, use the best move from the previous depth
             if (timeout)
@@ -371,7 +431,16 @@ Board::Move Game::smartMove()
             }
         }
         bestMove = move;
+        if (timeout)
+            break;
+        searchDepth = depth + 1;
+
+        //search the best move so far first at the next depth
+        legal.MoveToFront(move.square.y * BOARDSIZE + move.square.x);
     }
+    stopHelpers = true;
+    for (size_t t = 0; t < helpers.size(); t++)
+        helpers[t].join();
     //cout << "Searched to depth: " << depth << " in " << ((float)(clock() - startTime)) / CLOCKS_PER_SEC << " seconds" << endl;
     //cout << "Computer chose move " << moveNum << endl;
     //board.Print(vector<Board::Move>(1, move), true);
@@ -379,6 +448,121 @@ Board::Move Game::smartMove()
     return move;
 }
 
+//Board::Move Game::solveEndgame()
+//  pick the move with the best final disc difference for the
+//  current player, searching every empty square to the end
+Board::Move Game::solveEndgame()
+{
+    int opponent = (board.currentPlayer == WHITE)
+                       ? BLACK
+                       : WHITE;
+    uint64_t own = board.pieces[board.currentPlayer];
+    uint64_t opp = board.pieces[opponent];
+
+    Board::MoveList legal;
+    board.LegalMoves(board.currentPlayer, legal);
+    Board::Move move = legal[0];
+    int alpha = -NUMSQUARES - 1;
+    for (int i = 0; i < legal.size(); i++)
+    {
+        int square = legal[i].square.y * BOARDSIZE + legal[i].square.x;
+        uint64_t flips = legal[i].flips;
+        int eval = -solve(opp & ~flips, own | flips | (1ULL << square), -(NUMSQUARES + 1), -alpha, false);
+        if (eval > alpha)
+        {
+            move = legal[i];
+            alpha = eval;
+        }
+    }
+    searchDepth = NUMSQUARES - (board.score[BLACK] + board.score[WHITE]);
+    return move;
+}
+
+//int Game::solve(uint64_t own, uint64_t opp, int alpha, int beta, bool passed)
+//  negamax alpha beta search to the end of the game for the player
+//  owning own; returns the final disc difference (own - opp).
+//  Moves in quarters of the board with an odd number of empty
+//  squares are tried first (parity ordering).
+int Game::solve(uint64_t own, uint64_t opp, int alpha, int beta, bool passed)
+{
+    static const uint64_t quadrants[NUMQUADRANTS] = QUADRANTMASKS;
+    nodes++;
+
+    uint64_t moves = Board::MoveMask(own, opp);
+    if (!moves)
+    {
+        if (passed) //neither player can move
+            return Board::Count(own) - Board::Count(opp);
+        return -solve(opp, own, -beta, -alpha, true);
+    }
+
+    uint64_t empty = ~(own | opp), odd = 0;
+    for (int q = 0; q < NUMQUADRANTS; q++)
+        if (Board::Count(empty & quadrants[q]) & 1)
+            odd |= quadrants[q];
+
+    int v = -NUMSQUARES - 1;
+    uint64_t order[2] = {moves & odd, moves & ~odd};
+    for (int o = 0; o < 2; o++)
+    {
+        for (uint64_t bits = order[o]; bits; bits &= bits - 1)
+        {
+            int square = __builtin_ctzll(bits);
+            uint64_t flips = Board::FlipMask(own, opp, square);
+            int eval = -solve(opp & ~flips, own | flips | (1ULL << square), -beta, -alpha, false);
+            v = MAX(v, eval);
+            alpha = MAX(alpha, v);
+            if (alpha >= beta)
+                return v;
+        }
+    }
+    return v;
+}
+
+//void Game::helperSearch(int id, atomic<bool> *stopFlag)
+//  helper thread of a parallel smartMove: iterative deepening over
+//  the root moves, starting id % 2 plies deeper than the main search,
+//  until stopFlag is set. Its results only reach the main search
+//  through the shared transposition table.
+void Game::helperSearch(int id, atomic<bool> *stopFlag)
+{
+    Game helper(random, 0);
+    helper.tt = tt;
+    helper.board = board;
+    helper.maxPlayer = maxPlayer;
+    helper.timeLimit = timeLimit;
+    helper.threads = threads;
+    helper.startTime = startTime;
+    helper.startWall = startWall;
+    helper.stop = stopFlag;
+
+    int depthLimit = NUMSQUARES - (board.score[BLACK] + board.score[WHITE]);
+    Board::MoveList legal;
+    board.LegalMoves(board.currentPlayer, legal);
+    Board child = board;
+
+    for (int depth = id % 2; !stopFlag->load() && depth < depthLimit; depth++)
+    {
+        int alpha = INT_MIN, best = -1;
+        helper.timeout = false;
+        for (int i = 0; i < legal.size(); i++)
+        {
+            Board::Undo undo = child.MakeMove(legal[i]);
+            int eval = helper.alphabeta(child, depth, alpha, INT_MAX, false);
+            child.UnmakeMove(undo);
+            if (helper.timeout)
+                return;
+            if (eval > alpha)
+            {
+                alpha = eval;
+                best = legal[i].square.y * BOARDSIZE + legal[i].square.x;
+            }
+        }
+        if (best >= 0)
+            legal.MoveToFront(best);
+    }
+}
+
 //bool Game::randomMove()
 //  random move method for testing
 //  returns false if game in terminal state
@@ -0,0 +1,109 @@
+/*************************
+ * TTABLE.H
+ * transposition table for the alpha beta search
+ ************************/
+#ifndef _TTABLE_H_
+#define _TTABLE_H_
+
+#include <vector>
+#include <atomic>
+#include <stdint.h>
+
+using namespace std;
+
+
+#define TT_EXACT 0 //value is the minimax value of the node
+#define TT_LOWER 1 //search failed high, value is a lower bound
+#define TT_UPPER 2 //search failed low, value is an upper bound
+
+
+//the table can be shared by several searching threads: each slot is two
+//atomic words, and the key is stored xor'ed with the data so a slot
+//torn by concurrent writers simply reads as a miss
+class TTable{
+public:
+    class Entry{
+    public:
+        int value;
+        int depth;
+        int bound;
+        int best; //square (y*BOARDSIZE+x) of the best move found, -1 if none
+    };
+
+    //TTable::TTable(size_t size)
+    //  table with the largest power of two entries not above size (0 disables it)
+    TTable(size_t size = 0){
+        Resize(size);
+    }
+
+    //void TTable::Resize(size_t size)
+    //  reallocate the table, dropping all entries
+    void Resize(size_t size){
+        size_t entries = 0;
+        if(size > 0)
+            for(entries = 1; entries * 2 <= size; entries *= 2);
+        table = vector<Slot>(entries);
+        for(size_t i = 0; i < table.size(); i++){
+            table[i].check.store(0, memory_order_relaxed);
+            table[i].data.store(0, memory_order_relaxed);
+        }
+        age = 1;
+    }
+
+    //void TTable::NewSearch()
+    //  invalidate every entry (heuristic values depend on the root position)
+    void NewSearch(){
+        age = (age + 1) & AGEMASK;
+        if(age == 0)
+            age = 1;
+    }
+
+    //bool TTable::Probe(uint64_t key, TTable::Entry &entry)
+    //  look up key, filling entry if it was stored during the current search
+    bool Probe(uint64_t key, Entry &entry){
+        if(table.empty())
+            return false;
+        Slot &slot = table[key & (table.size() - 1)];
+        uint64_t data = slot.data.load(memory_order_relaxed);
+        if((slot.check.load(memory_order_relaxed) ^ data) != key || (data >> 49) != age)
+            return false;
+        entry.value = (int32_t)(uint32_t)data;
+        entry.depth = (int)((data >> 32) & 0xff);
+        entry.bound = (int)((data >> 40) & 0x3);
+        entry.best = ((data >> 42) & 1) ? (int)((data >> 43) & 0x3f) : -1;
+        return true;
+    }
+
+    //void TTable::Store(uint64_t key, int value, int depth, int bound, int best)
+    //  record a search result, keeping deeper results from the current search
+    void Store(uint64_t key, int value, int depth, int bound, int best){
+        if(table.empty())
+            return;
+        Slot &slot = table[key & (table.size() - 1)];
+        uint64_t old = slot.data.load(memory_order_relaxed);
+        if((old >> 49) == age && (slot.check.load(memory_order_relaxed) ^ old) != key
+           && (int)((old >> 32) & 0xff) > depth)
+            return;
+        uint64_t data = (uint64_t)(uint32_t)value
+            | ((uint64_t)(depth & 0xff) << 32)
+            | ((uint64_t)(bound & 0x3) << 40)
+            | ((best >= 0) ? (((uint64_t)1 << 42) | ((uint64_t)(best & 0x3f) << 43)) : 0)
+            | ((uint64_t)age << 49);
+        slot.check.store(key ^ data, memory_order_relaxed);
+        slot.data.store(data, memory_order_relaxed);
+    }
+
+private:
+    static const unsigned int AGEMASK = 0x7fff; //ages wrap after 32767 searches
+
+    class Slot{
+    public:
+        atomic<uint64_t> check; //key ^ data
+        atomic<uint64_t> data;  //value, depth, bound, best move and age packed
+    };
+
+    vector<Slot> table;
+    unsigned int age;
+};
+
+#endif //_TTABLE_H_
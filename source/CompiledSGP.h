@@ -0,0 +1,951 @@
+#ifndef COMPILED_SGP_H
+#define COMPILED_SGP_H
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+#include "base/array.h"
+#include "base/assert.h"
+#include "base/Ptr.h"
+#include "base/vector.h"
+#include "hardware/EventDrivenGP.h"
+#include "tools/BitSet.h"
+#include "tools/Random.h"
+
+#include "RegisterFile.h"
+
+/// SignalGP hardware that runs programs compiled to flat bytecode. Drop-in replacement for
+/// emp::EventDrivenGP_AW: same program, state, instruction and event library types, and the
+/// same execution semantics, but a program is flattened into an Executable before it runs.
+/// An Executable lays every function's instructions end to end in one array and works out
+/// where each block ends ahead of time, so If, While and Countdown don't scan for their Close.
+/// Compile an Executable once per genome and bind it with SetProgram, which doesn't copy it.
+/// The default instructions are run through a switch; everything else goes through the
+/// instruction library as usual.
+/// Tag matching (Call, spawning cores) is looked up rather than searched for each time.
+/// Memory keys 0 to MEM_SIZE-1 are kept in fixed registers (see RegisterFile).
+template <size_t AFFINITY_WIDTH, size_t MEM_SIZE=0>
+class CompiledSGP {
+public:
+  static constexpr size_t MAX_INST_ARGS = 3;
+
+  using hardware_t = CompiledSGP<AFFINITY_WIDTH, MEM_SIZE>;
+  using memory_t = RegisterFile<MEM_SIZE>;
+  using mem_key_t = typename memory_t::key_t;
+  using mem_val_t = typename memory_t::value_t;
+  using arg_t = int;
+  using arg_set_t = emp::array<arg_t, MAX_INST_ARGS>;
+  using affinity_t = emp::BitSet<AFFINITY_WIDTH>;
+  using properties_t = std::unordered_set<std::string>;
+
+  struct Instruction {
+    size_t id;
+    arg_set_t args;
+    affinity_t affinity;
+
+    Instruction(size_t _id=0, arg_t a0=0, arg_t a1=0, arg_t a2=0, const affinity_t & _aff=affinity_t())
+      : id(_id), args(), affinity(_aff) { args[0] = a0; args[1] = a1; args[2] = a2; }
+
+    void Set(size_t _id, arg_t a0=0, arg_t a1=0, arg_t a2=0, const affinity_t & _aff=affinity_t()) {
+      id = _id; args[0] = a0; args[1] = a1; args[2] = a2; affinity = _aff;
+    }
+
+    bool operator==(const Instruction & in) const {
+      return id == in.id && args == in.args && affinity == in.affinity;
+    }
+    bool operator!=(const Instruction & in) const { return !(*this == in); }
+    bool operator<(const Instruction & in) const {
+      if (id != in.id) return id < in.id;
+      for (size_t i = 0; i < MAX_INST_ARGS; ++i) {
+        if (args[i] != in.args[i]) return args[i] < in.args[i];
+      }
+      return affinity < in.affinity;
+    }
+  };
+
+  using inst_t = Instruction;
+  using inst_lib_t = emp::InstLib<hardware_t>;
+
+  struct Event {
+    size_t id;
+    affinity_t affinity;
+    memory_t msg;
+    properties_t properties;
+
+    Event(size_t _id=0, const affinity_t & _aff=affinity_t(), const memory_t & _msg=memory_t(),
+          const properties_t & _properties=properties_t())
+      : id(_id), affinity(_aff), msg(_msg), properties(_properties) { ; }
+  };
+
+  using event_t = Event;
+  using event_lib_t = emp::EventLib<hardware_t>;
+
+  enum class BlockType { NONE=0, BASIC, LOOP };
+
+  struct Block {
+    size_t begin;
+    size_t end;
+    BlockType type;
+
+    Block(size_t _begin=0, size_t _end=0, BlockType _type=BlockType::BASIC)
+      : begin(_begin), end(_end), type(_type) { ; }
+  };
+
+  /// Call state of one function on one core.
+  struct State {
+    emp::Ptr<memory_t> shared_mem_ptr;
+    memory_t local_mem;
+    memory_t input_mem;
+    memory_t output_mem;
+    mem_val_t default_mem_val;
+    size_t func_ptr;
+    size_t inst_ptr;
+    emp::vector<Block> block_stack;
+    bool is_main;
+
+    State(emp::Ptr<memory_t> _shared_mem=nullptr, bool _is_main=false)
+      : shared_mem_ptr(_shared_mem), default_mem_val(0.0), func_ptr(0), inst_ptr(0), is_main(_is_main) { ; }
+
+    void Reset() {
+      local_mem.clear(); input_mem.clear(); output_mem.clear();
+      func_ptr = 0; inst_ptr = 0;
+      block_stack.clear();
+    }
+
+    size_t GetIP() const { return inst_ptr; }
+    size_t GetFP() const { return func_ptr; }
+    void SetIP(size_t ip) { inst_ptr = ip; }
+    void SetFP(size_t fp) { func_ptr = fp; }
+    void SetDefaultMemValue(mem_val_t val) { default_mem_val = val; }
+
+    memory_t & GetLocalMemory() { return local_mem; }
+    memory_t & GetInputMemory() { return input_mem; }
+    memory_t & GetOutputMemory() { return output_mem; }
+
+    mem_val_t GetLocal(mem_key_t key) const { return Get(local_mem, key); }
+    mem_val_t GetInput(mem_key_t key) const { return Get(input_mem, key); }
+    mem_val_t GetOutput(mem_key_t key) const { return Get(output_mem, key); }
+
+    void SetLocal(mem_key_t key, mem_val_t val) { local_mem.Set(key, val); }
+    void SetInput(mem_key_t key, mem_val_t val) { input_mem.Set(key, val); }
+    void SetOutput(mem_key_t key, mem_val_t val) { output_mem.Set(key, val); }
+
+    mem_val_t & AccessLocal(mem_key_t key) { return local_mem.Access(key, default_mem_val); }
+    mem_val_t & AccessInput(mem_key_t key) { return input_mem.Access(key, default_mem_val); }
+    mem_val_t & AccessOutput(mem_key_t key) { return output_mem.Access(key, default_mem_val); }
+
+  protected:
+    mem_val_t Get(const memory_t & mem, mem_key_t key) const { return mem.Get(key, default_mem_val); }
+  };
+
+  struct Function {
+    affinity_t affinity;
+    emp::vector<inst_t> inst_seq;
+
+    Function(const affinity_t & _aff=affinity_t(), const emp::vector<inst_t> & _seq=emp::vector<inst_t>())
+      : affinity(_aff), inst_seq(_seq) { ; }
+
+    size_t GetSize() const { return inst_seq.size(); }
+    affinity_t & GetAffinity() { return affinity; }
+    const affinity_t & GetAffinity() const { return affinity; }
+    void SetAffinity(const affinity_t & _aff) { affinity = _aff; }
+
+    inst_t & operator[](size_t id) { return inst_seq[id]; }
+    const inst_t & operator[](size_t id) const { return inst_seq[id]; }
+    bool operator==(const Function & in) const { return inst_seq == in.inst_seq && affinity == in.affinity; }
+    bool operator!=(const Function & in) const { return !(*this == in); }
+    bool operator<(const Function & in) const {
+      if (!(affinity == in.affinity)) return affinity < in.affinity;
+      return inst_seq < in.inst_seq;
+    }
+
+    void PushInst(size_t id, arg_t a0=0, arg_t a1=0, arg_t a2=0, const affinity_t & _aff=affinity_t()) {
+      inst_seq.emplace_back(id, a0, a1, a2, _aff);
+    }
+    void PushInst(const inst_t & inst) { inst_seq.push_back(inst); }
+  };
+
+  struct Program {
+    emp::Ptr<const inst_lib_t> inst_lib;
+    emp::vector<Function> program;
+
+    Program(emp::Ptr<const inst_lib_t> _ilib=nullptr, const emp::vector<Function> & _program=emp::vector<Function>())
+      : inst_lib(_ilib), program(_program) { ; }
+
+    void Clear() { program.clear(); }
+
+    Function & operator[](size_t id) { return program[id]; }
+    const Function & operator[](size_t id) const { return program[id]; }
+    bool operator==(const Program & in) const { return program == in.program; }
+    bool operator!=(const Program & in) const { return !(*this == in); }
+    bool operator<(const Program & in) const { return program < in.program; }
+
+    size_t GetSize() const { return program.size(); }
+    size_t GetInstCnt() const {
+      size_t cnt = 0;
+      for (const Function & fun : program) cnt += fun.GetSize();
+      return cnt;
+    }
+    emp::Ptr<const inst_lib_t> GetInstLib() const { return inst_lib; }
+    bool ValidPosition(size_t fp, size_t ip) const { return fp < program.size() && ip < program[fp].GetSize(); }
+
+    /// Hash of every function affinity, instruction, argument and instruction affinity, so
+    /// programs that compare equal hash equal. Continue from hash to hash several programs.
+    uint64_t Hash(uint64_t hash=0) const {
+      auto add = [&hash](uint64_t val) {
+        uint64_t z = (hash ^ val) + 0x9e3779b97f4a7c15ULL; // SplitMix64 finalizer
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        hash = z ^ (z >> 31);
+      };
+      auto add_affinity = [&add](const affinity_t & aff) {
+        uint64_t word = 0;
+        for (size_t i = 0; i < AFFINITY_WIDTH; ++i) {
+          word = (word << 1) | (uint64_t)aff.Get(i);
+          if (i % 64 == 63 || i + 1 == AFFINITY_WIDTH) { add(word); word = 0; }
+        }
+      };
+      add(program.size());
+      for (const Function & fun : program) {
+        add_affinity(fun.affinity);
+        add(fun.inst_seq.size());
+        for (const inst_t & inst : fun.inst_seq) {
+          add(inst.id);
+          for (size_t i = 0; i < MAX_INST_ARGS; ++i) add((uint64_t)(int64_t)inst.args[i]);
+          add_affinity(inst.affinity);
+        }
+      }
+      return hash;
+    }
+
+    void SetProgram(const emp::vector<Function> & _program) { program = _program; }
+    void PushFunction(const Function & fun) { program.push_back(fun); }
+    void PushFunction(const affinity_t & _aff=affinity_t(), const emp::vector<inst_t> & _seq=emp::vector<inst_t>()) {
+      program.emplace_back(_aff, _seq);
+    }
+    void PushInst(size_t id, arg_t a0=0, arg_t a1=0, arg_t a2=0, const affinity_t & _aff=affinity_t(), int fID=-1) {
+      program[(fID < 0) ? program.size() - 1 : (size_t)fID].PushInst(id, a0, a1, a2, _aff);
+    }
+    void PushInst(const inst_t & inst, int fID=-1) {
+      program[(fID < 0) ? program.size() - 1 : (size_t)fID].PushInst(inst);
+    }
+
+    /// Read a program written by PrintProgramFull (or by hand in the same layout): a
+    /// "Fn-<affinity>:" line starts each function and every other line is an instruction,
+    /// "Name(arg,arg,arg)[affinity]", where the arguments and affinity may be left out.
+    void Load(std::istream & input) {
+      program.clear();
+      std::string line;
+      while (std::getline(input, line)) {
+        const size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos) continue;
+        line = line.substr(start, line.find_last_not_of(" \t\r") + 1 - start);
+
+        if (line.compare(0, 3, "Fn-") == 0) {
+          affinity_t affinity;
+          ReadAffinity(line.substr(3, line.find(':') - 3), affinity);
+          PushFunction(affinity);
+          continue;
+        }
+
+        if (program.empty()) PushFunction();
+        inst_t inst(inst_lib->GetID(line.substr(0, line.find_first_of("([ \t"))));
+        const size_t arg_begin = line.find('('), arg_end = line.find(')');
+        if (arg_begin != std::string::npos && arg_end != std::string::npos) {
+          std::string args = line.substr(arg_begin + 1, arg_end - arg_begin - 1);
+          for (char & c : args) if (c == ',') c = ' ';
+          std::stringstream arg_stream(args);
+          for (size_t i = 0; i < MAX_INST_ARGS && (arg_stream >> inst.args[i]); ++i);
+        }
+        const size_t aff_begin = line.find('['), aff_end = line.find(']');
+        if (aff_begin != std::string::npos && aff_end != std::string::npos) {
+          ReadAffinity(line.substr(aff_begin + 1, aff_end - aff_begin - 1), inst.affinity);
+        }
+        PushInst(inst);
+      }
+    }
+
+    /// Print one instruction; only instructions that use their affinity show it.
+    void PrintInst(const inst_t & inst, std::ostream & os=std::cout) const {
+      os << inst_lib->GetName(inst.id) << '(' << inst.args[0];
+      for (size_t i = 1; i < MAX_INST_ARGS; ++i) os << ',' << inst.args[i];
+      os << ')';
+      if (inst_lib->HasProperty(inst.id, "affinity")) {
+        os << '[';
+        inst.affinity.Print(os);
+        os << ']';
+      }
+    }
+
+    /// Print the whole program, indenting the body of every block, in the layout Load reads.
+    void PrintProgramFull(std::ostream & os=std::cout) const {
+      for (const Function & fun : program) {
+        os << "Fn-";
+        fun.affinity.Print(os);
+        os << ":\n";
+        size_t depth = 0;
+        for (const inst_t & inst : fun.inst_seq) {
+          os << std::string(2 * (depth + 1), ' ');
+          PrintInst(inst, os);
+          os << '\n';
+          if (inst_lib->HasProperty(inst.id, "block_def")) ++depth;
+          else if (inst_lib->HasProperty(inst.id, "block_close") && depth) --depth;
+        }
+      }
+    }
+
+  protected:
+    /// Affinities are written most significant bit first.
+    static void ReadAffinity(const std::string & bits, affinity_t & affinity) {
+      for (size_t i = 0; i < bits.size() && i < AFFINITY_WIDTH; ++i) {
+        affinity.Set(AFFINITY_WIDTH - 1 - i, bits[i] == '1');
+      }
+    }
+  };
+
+  using program_t = Program;
+
+  /// One instruction of an Executable.
+  struct Op {
+    inst_t inst;      ///< Instruction as written in the program.
+    bool block_def;   ///< Does this instruction open a block (If, While, Countdown...)?
+    bool block_close; ///< Does this instruction close a block?
+    size_t block_end; ///< For block openers: position of the matching close (or the function's end).
+  };
+
+  /// The functions that match a tag best, and how well they match it.
+  struct Match {
+    double score;             ///< Best match coefficient of any function (0 if there are none).
+    emp::vector<size_t> funs; ///< Every function with that score, in order.
+  };
+
+  /// A program flattened for execution: the instructions of every function end to end in
+  /// one array, with block ends resolved, and tag matches worked out for every affinity the
+  /// program's own instructions carry. Build one per genome with Compile.
+  struct Executable {
+    emp::vector<Op> code;                 ///< Instructions of function 0, then function 1, ...
+    emp::vector<size_t> fun_start;        ///< Position of each function in code, plus code's end.
+    emp::vector<affinity_t> fun_affinity; ///< Affinity of each function.
+    emp::vector<affinity_t> match_tag;    ///< Instruction affinities, sorted.
+    emp::vector<Match> match;             ///< Best matching functions for each of match_tag.
+
+    Executable() : code(), fun_start(1, 0), fun_affinity(), match_tag(), match() { ; }
+
+    /// Flatten program for hardware running instruction library lib (the program's own by
+    /// default), leaving out code that can never run: whatever follows a Return, a Break inside
+    /// a block, or an instruction with the "halt" property (after which the hardware isn't run
+    /// again until it is reset), up to the Close of the enclosing block. Blocks, exits and
+    /// affinities are all read from lib, so only bind the result to hardware running lib.
+    /// The program itself is untouched.
+    void Compile(const Program & program) { Compile(program, *program.GetInstLib()); }
+    void Compile(const Program & program, const inst_lib_t & lib) {
+      emp::vector<bool> is_def(lib.GetSize()), is_close(lib.GetSize()), is_exit(lib.GetSize()), is_break(lib.GetSize());
+      for (size_t id = 0; id < lib.GetSize(); ++id) {
+        const inst_fun_t * fun = lib.GetFunction(id).template target<inst_fun_t>();
+        is_def[id] = lib.HasProperty(id, "block_def");
+        is_close[id] = lib.HasProperty(id, "block_close");
+        is_exit[id] = lib.HasProperty(id, "halt") || (fun && *fun == Inst_Return);
+        is_break[id] = fun && *fun == Inst_Break;
+      }
+      // First Close at or after ip that no opener after ip matches (or the end of seq).
+      auto scan_close = [&is_def, &is_close](const emp::vector<inst_t> & seq, size_t ip) {
+        int depth = 1;
+        for (; ip < seq.size(); ++ip) {
+          if (is_def[seq[ip].id]) ++depth;
+          else if (is_close[seq[ip].id] && --depth == 0) break;
+        }
+        return ip;
+      };
+
+      code.clear();
+      code.reserve(program.GetInstCnt());
+      fun_start.clear();
+      fun_affinity.clear();
+      match_tag.clear();
+      for (size_t fp = 0; fp < program.GetSize(); ++fp) {
+        const emp::vector<inst_t> & seq = program[fp].inst_seq;
+        fun_start.push_back(code.size());
+        fun_affinity.push_back(program[fp].affinity);
+        size_t depth = 0; // Blocks the hardware has open when it reaches ip.
+        for (size_t ip = 0; ip < seq.size(); ++ip) {
+          const inst_t & inst = seq[ip];
+          code.push_back({inst, is_def[inst.id], is_close[inst.id], 0});
+          if (lib.HasProperty(inst.id, "affinity")) match_tag.push_back(inst.affinity);
+          if (is_def[inst.id]) ++depth;
+          else if (is_close[inst.id] && depth) --depth;
+          if (is_exit[inst.id] || (is_break[inst.id] && depth)) {
+            ip = depth ? scan_close(seq, ip + 1) - 1 : seq.size();
+          }
+        }
+      }
+      fun_start.push_back(code.size());
+
+      std::sort(match_tag.begin(), match_tag.end());
+      match_tag.erase(std::unique(match_tag.begin(), match_tag.end()), match_tag.end());
+      match.resize(match_tag.size());
+      for (size_t i = 0; i < match_tag.size(); ++i) match[i] = CalcMatch(match_tag[i]);
+
+      for (size_t fp = 0; fp < GetSize(); ++fp) {
+        for (size_t ip = 0; ip < GetFunSize(fp); ++ip) {
+          Op & op = code[fun_start[fp] + ip];
+          if (op.block_def) op.block_end = ScanEndOfBlock(fp, ip + 1);
+        }
+      }
+    }
+
+    size_t GetSize() const { return fun_affinity.size(); }
+    size_t GetFunSize(size_t fp) const { return fun_start[fp + 1] - fun_start[fp]; }
+    size_t GetInstCnt() const { return code.size(); }
+    bool ValidPosition(size_t fp, size_t ip) const { return fp < GetSize() && ip < GetFunSize(fp); }
+    const Op & GetOp(size_t fp, size_t ip) const { return code[fun_start[fp] + ip]; }
+
+    /// Functions whose affinity matches tag best, however poorly that is.
+    Match CalcMatch(const affinity_t & tag) const {
+      Match result{0.0, {}};
+      for (size_t fp = 0; fp < GetSize(); ++fp) {
+        const double bit_match = emp::SimpleMatchCoeff(fun_affinity[fp], tag);
+        if (result.funs.size() && bit_match < result.score) continue;
+        if (result.funs.empty() || bit_match > result.score) {
+          result.score = bit_match;
+          result.funs.clear();
+        }
+        result.funs.push_back(fp);
+      }
+      return result;
+    }
+
+    /// Precomputed match for tag, or nullptr if no instruction in the program carries it.
+    const Match * FindMatch(const affinity_t & tag) const {
+      auto it = std::lower_bound(match_tag.begin(), match_tag.end(), tag);
+      if (it == match_tag.end() || tag < *it) return nullptr;
+      return &match[(size_t)(it - match_tag.begin())];
+    }
+
+    /// Position of the close that ends the block containing ip, i.e. the first close with
+    /// no matching opener at or after ip (or the end of the function if there is none).
+    size_t ScanEndOfBlock(size_t fp, size_t ip) const {
+      if (fp >= GetSize()) return ip;
+      int depth = 1;
+      for (; ip < GetFunSize(fp); ++ip) {
+        const Op & op = GetOp(fp, ip);
+        if (op.block_def) ++depth;
+        else if (op.block_close && --depth == 0) break;
+      }
+      return ip;
+    }
+  };
+
+  /// Call stack of one core. Popped states stay allocated and are reset when a later call
+  /// reuses them, so a core doesn't allocate once its stack has been that deep before.
+  struct CallStack {
+    emp::vector<State> states;
+    size_t depth;
+
+    CallStack() : states(), depth(0) { ; }
+
+    size_t size() const { return depth; }
+    bool empty() const { return !depth; }
+    State & operator[](size_t i) { return states[i]; }
+    State & back() { return states[depth - 1]; }
+    void clear() { depth = 0; }
+    void pop_back() { --depth; }
+
+    /// Push a state with empty memory, at the start of function 0.
+    State & Push(emp::Ptr<memory_t> shared_mem, bool is_main) {
+      if (depth == states.size()) states.emplace_back(shared_mem, is_main);
+      else {
+        State & state = states[depth];
+        state.Reset();
+        state.shared_mem_ptr = shared_mem;
+        state.is_main = is_main;
+      }
+      return states[depth++];
+    }
+  };
+
+  using exec_stk_t = CallStack;
+
+  /// Default instructions the hardware runs through a switch rather than the library.
+  enum class InstOp : unsigned char {
+    LIBRARY=0, INC, DEC, NOT, ADD, SUB, MULT, DIV, MOD, TEST_EQU, TEST_NEQU, TEST_LESS, IF, WHILE,
+    COUNTDOWN, CLOSE, BREAK, CALL, RETURN, SET_MEM, COPY_MEM, SWAP_MEM, INPUT, OUTPUT, COMMIT, PULL, NOP
+  };
+
+protected:
+  using inst_fun_t = void (*)(hardware_t &, const inst_t &);
+
+  emp::Ptr<const inst_lib_t> inst_lib;
+  emp::vector<InstOp> inst_ops; ///< How to run each instruction in inst_lib (see RefreshInstLib).
+  emp::Ptr<const event_lib_t> event_lib;
+  emp::Ptr<emp::Random> random_ptr;
+  bool random_owner;
+  Executable compiled;               ///< Program compiled by SetProgram(const Program &).
+  emp::Ptr<const Executable> exec;   ///< Program being run (compiled, or one bound by the caller).
+  std::map<affinity_t, Match> match_memo; ///< Matches for tags exec didn't precompute (e.g. messages).
+  memory_t shared_mem;
+  emp::vector<event_t> event_queue;
+  emp::vector<event_t> handling_events; ///< Events being handled (event_queue collects new ones meanwhile).
+  emp::vector<double> traits;
+  size_t errors;
+  size_t max_cores;
+  size_t max_call_depth;
+  mem_val_t default_mem_val;
+  double min_bind_thresh;
+  emp::vector<exec_stk_t> cores;
+  size_t used_cores; ///< Cores [0, used_cores) may have run since the last reset.
+  emp::vector<size_t> active_cores;
+  emp::vector<size_t> inactive_cores;
+  std::deque<size_t> pending_cores;
+  size_t exec_core_id;
+  bool is_executing;
+
+public:
+  CompiledSGP(emp::Ptr<const inst_lib_t> _ilib, emp::Ptr<const event_lib_t> _elib, emp::Ptr<emp::Random> rnd=nullptr)
+    : inst_lib(_ilib), inst_ops(), event_lib(_elib), random_ptr(rnd), random_owner(false), compiled(), exec(&compiled), match_memo(), shared_mem(),
+      event_queue(), handling_events(), traits(), errors(0), max_cores(64), max_call_depth(128), default_mem_val(0.0),
+      min_bind_thresh(0.5), cores(max_cores), used_cores(max_cores), active_cores(), inactive_cores(max_cores), pending_cores(),
+      exec_core_id(0), is_executing(false)
+  {
+    if (!rnd) { random_ptr = emp::NewPtr<emp::Random>(); random_owner = true; }
+    ResetHardware();
+  }
+
+  CompiledSGP(const hardware_t &) = delete;
+  hardware_t & operator=(const hardware_t &) = delete;
+
+  ~CompiledSGP() { if (random_owner) random_ptr.Delete(); }
+
+  /// Unload the program and clear every trait, as well as the hardware state.
+  void Reset() {
+    compiled = Executable();
+    exec = &compiled;
+    match_memo.clear();
+    traits.clear();
+    ResetHardware();
+  }
+
+  /// Clear memory, events and cores, keeping the program and traits. Only cores that have
+  /// run since the last reset are cleared, and all storage stays allocated for reuse.
+  void ResetHardware() {
+    shared_mem.clear();
+    event_queue.clear();
+    for (size_t i = 0; i < used_cores; ++i) cores[i].clear();
+    active_cores.clear();
+    pending_cores.clear();
+    // Cores are handed out lowest ID first, so only the top used_cores IDs left the stack.
+    inactive_cores.resize(max_cores - used_cores);
+    for (size_t i = used_cores; i > 0; --i) inactive_cores.push_back(i - 1);
+    used_cores = 0;
+    exec_core_id = (size_t)-1;
+    is_executing = false;
+    errors = 0;
+  }
+
+  emp::Ptr<const inst_lib_t> GetInstLib() const { return inst_lib; }
+  emp::Ptr<const event_lib_t> GetEventLib() const { return event_lib; }
+  emp::Random & GetRandom() { return *random_ptr; }
+  emp::Ptr<emp::Random> GetRandomPtr() { return random_ptr; }
+  const Executable & GetExecutable() const { return *exec; }
+  double GetTrait(size_t id) const { return traits[id]; }
+  emp::vector<double> & GetTraits() { return traits; }
+  size_t GetNumErrors() const { return errors; }
+  double GetMinBindThresh() const { return min_bind_thresh; }
+  size_t GetMaxCores() const { return max_cores; }
+  size_t GetMaxCallDepth() const { return max_call_depth; }
+  mem_val_t GetDefaultMemValue() const { return default_mem_val; }
+  const emp::vector<size_t> & GetActiveCores() const { return active_cores; }
+  const emp::vector<size_t> & GetInactiveCores() const { return inactive_cores; }
+  size_t GetCurCoreID() const { return exec_core_id; }
+  exec_stk_t & GetCurCore() { return cores[exec_core_id]; }
+  State & GetCurState() { return cores[exec_core_id].back(); }
+  memory_t & GetSharedMem() { return shared_mem; }
+  size_t GetEventQueueSize() const { return event_queue.size(); }
+
+  /// Nothing left to run: no cores, and no queued events that could start one.
+  bool IsIdle() const { return active_cores.empty() && pending_cores.empty() && event_queue.empty(); }
+
+  mem_val_t GetShared(mem_key_t key) const { return shared_mem.Get(key, default_mem_val); }
+  mem_val_t & AccessShared(mem_key_t key) { return shared_mem.Access(key, default_mem_val); }
+  void SetShared(mem_key_t key, mem_val_t val) { shared_mem.Set(key, val); }
+
+  /// Compile program for this hardware's instruction library and load it, resetting the hardware.
+  void SetProgram(const Program & program) {
+    compiled.Compile(program, *inst_lib);
+    exec = &compiled;
+    match_memo.clear();
+    ResetHardware();
+  }
+
+  /// Run an already compiled program, resetting the hardware. The program isn't copied, so
+  /// it must stay alive and unchanged for as long as it is bound; binding is O(1).
+  void SetProgram(const Executable & _exec) {
+    exec = &_exec;
+    match_memo.clear();
+    ResetHardware();
+  }
+
+  void SetTrait(size_t id, double val) {
+    if (id >= traits.size()) traits.resize(id + 1, 0.0);
+    traits[id] = val;
+  }
+  void SetMinBindThresh(double val) { min_bind_thresh = val; }
+  void SetMaxCallDepth(size_t val) { max_call_depth = val; }
+  void SetDefaultMemValue(mem_val_t val) { default_mem_val = val; }
+  void SetMaxCores(size_t val) {
+    emp_assert(val > 0);
+    max_cores = val;
+    cores.resize(max_cores);
+    used_cores = max_cores;
+    ResetHardware();
+  }
+  void SetRandom(emp::Ptr<emp::Random> rnd) {
+    if (random_owner) random_ptr.Delete();
+    random_ptr = rnd;
+    random_owner = false;
+  }
+
+  /// Work out which library instructions are default instructions the hardware can run itself,
+  /// recognized by their definition rather than their name (so a knocked out instruction is
+  /// never run inline). Instructions added to the library are picked up automatically, but
+  /// call this again whenever existing instructions get new definitions (emp::InstLib::UpdateInst).
+  void RefreshInstLib() {
+    static const std::pair<inst_fun_t, InstOp> defaults[] = {
+      {Inst_Inc, InstOp::INC}, {Inst_Dec, InstOp::DEC}, {Inst_Not, InstOp::NOT}, {Inst_Add, InstOp::ADD},
+      {Inst_Sub, InstOp::SUB}, {Inst_Mult, InstOp::MULT}, {Inst_Div, InstOp::DIV}, {Inst_Mod, InstOp::MOD},
+      {Inst_TestEqu, InstOp::TEST_EQU}, {Inst_TestNEqu, InstOp::TEST_NEQU}, {Inst_TestLess, InstOp::TEST_LESS},
+      {Inst_If, InstOp::IF}, {Inst_While, InstOp::WHILE}, {Inst_Countdown, InstOp::COUNTDOWN},
+      {Inst_Close, InstOp::CLOSE}, {Inst_Break, InstOp::BREAK}, {Inst_Call, InstOp::CALL},
+      {Inst_Return, InstOp::RETURN}, {Inst_SetMem, InstOp::SET_MEM}, {Inst_CopyMem, InstOp::COPY_MEM},
+      {Inst_SwapMem, InstOp::SWAP_MEM}, {Inst_Input, InstOp::INPUT}, {Inst_Output, InstOp::OUTPUT},
+      {Inst_Commit, InstOp::COMMIT}, {Inst_Pull, InstOp::PULL}, {Inst_Nop, InstOp::NOP}
+    };
+    inst_ops.assign(inst_lib->GetSize(), InstOp::LIBRARY);
+    for (size_t id = 0; id < inst_ops.size(); ++id) {
+      const inst_fun_t * fun = inst_lib->GetFunction(id).template target<inst_fun_t>();
+      if (!fun) continue;
+      for (const auto & def : defaults) {
+        if (*fun == def.first) { inst_ops[id] = def.second; break; }
+      }
+    }
+  }
+
+  /// Run one instruction on the current core.
+  void ProcessInst(const inst_t & inst) {
+    switch (inst_ops[inst.id]) {
+      case InstOp::INC: Inst_Inc(*this, inst); break;
+      case InstOp::DEC: Inst_Dec(*this, inst); break;
+      case InstOp::NOT: Inst_Not(*this, inst); break;
+      case InstOp::ADD: Inst_Add(*this, inst); break;
+      case InstOp::SUB: Inst_Sub(*this, inst); break;
+      case InstOp::MULT: Inst_Mult(*this, inst); break;
+      case InstOp::DIV: Inst_Div(*this, inst); break;
+      case InstOp::MOD: Inst_Mod(*this, inst); break;
+      case InstOp::TEST_EQU: Inst_TestEqu(*this, inst); break;
+      case InstOp::TEST_NEQU: Inst_TestNEqu(*this, inst); break;
+      case InstOp::TEST_LESS: Inst_TestLess(*this, inst); break;
+      case InstOp::IF: Inst_If(*this, inst); break;
+      case InstOp::WHILE: Inst_While(*this, inst); break;
+      case InstOp::COUNTDOWN: Inst_Countdown(*this, inst); break;
+      case InstOp::CLOSE: Inst_Close(*this, inst); break;
+      case InstOp::BREAK: Inst_Break(*this, inst); break;
+      case InstOp::CALL: Inst_Call(*this, inst); break;
+      case InstOp::RETURN: Inst_Return(*this, inst); break;
+      case InstOp::SET_MEM: Inst_SetMem(*this, inst); break;
+      case InstOp::COPY_MEM: Inst_CopyMem(*this, inst); break;
+      case InstOp::SWAP_MEM: Inst_SwapMem(*this, inst); break;
+      case InstOp::INPUT: Inst_Input(*this, inst); break;
+      case InstOp::OUTPUT: Inst_Output(*this, inst); break;
+      case InstOp::COMMIT: Inst_Commit(*this, inst); break;
+      case InstOp::PULL: Inst_Pull(*this, inst); break;
+      case InstOp::NOP: break;
+      default: inst_lib->ProcessInst(*this, inst); break;
+    }
+  }
+
+  /// Position of the end of the block that ip (in function fp) is in; see Executable::ScanEndOfBlock.
+  /// Blocks opened by an instruction were resolved when the program was compiled.
+  size_t FindEndOfBlock(size_t fp, size_t ip) const {
+    if (ip && exec->ValidPosition(fp, ip - 1)) {
+      const Op & op = exec->GetOp(fp, ip - 1);
+      if (op.block_def) return op.block_end;
+    }
+    return exec->ScanEndOfBlock(fp, ip);
+  }
+
+  void OpenBlock(size_t begin, size_t end, BlockType type) {
+    GetCurState().block_stack.emplace_back(begin, end, type);
+  }
+
+  void CloseBlock() {
+    State & state = GetCurState();
+    if (state.block_stack.empty()) return;
+    const Block & block = state.block_stack.back();
+    if (block.type == BlockType::LOOP) state.inst_ptr = block.begin;
+    state.block_stack.pop_back();
+  }
+
+  void BreakBlock() {
+    State & state = GetCurState();
+    if (state.block_stack.empty()) return;
+    state.inst_ptr = state.block_stack.back().end;
+    if (exec->ValidPosition(state.func_ptr, state.inst_ptr)) ++state.inst_ptr;
+    state.block_stack.pop_back();
+  }
+
+  void AdvanceIP(size_t inc=1) { GetCurState().inst_ptr += inc; }
+
+  /// Functions whose affinity matches affinity best, found in the program's precomputed
+  /// matches or worked out once per bound program.
+  const Match & GetMatch(const affinity_t & affinity) {
+    const Match * match = exec->FindMatch(affinity);
+    if (match) return *match;
+    auto it = match_memo.find(affinity);
+    if (it == match_memo.end()) it = match_memo.emplace(affinity, exec->CalcMatch(affinity)).first;
+    return it->second;
+  }
+
+  /// Functions whose affinity matches affinity best, and at least as well as threshold.
+  emp::vector<size_t> FindBestFuncMatch(const affinity_t & affinity, double threshold) {
+    const Match & match = GetMatch(affinity);
+    if (match.score < threshold) return emp::vector<size_t>();
+    return match.funs;
+  }
+
+  /// Pick one of the best matching functions (at random if there is a tie); false if none match.
+  bool SelectFunction(const affinity_t & affinity, double threshold, size_t & fID) {
+    const Match & match = GetMatch(affinity);
+    if (match.funs.empty() || match.score < threshold) return false;
+    fID = (match.funs.size() == 1) ? match.funs[0] : match.funs[random_ptr->GetUInt(match.funs.size())];
+    return true;
+  }
+
+  void CallFunction(const affinity_t & affinity, double threshold) {
+    size_t fID;
+    if (SelectFunction(affinity, threshold, fID)) CallFunction(fID);
+  }
+
+  void CallFunction(size_t fID) {
+    exec_stk_t & core = GetCurCore();
+    if (core.size() >= max_call_depth) return;
+    State & new_state = core.Push(&shared_mem, false);
+    State & caller_state = core[core.size() - 2];
+    new_state.SetDefaultMemValue(default_mem_val);
+    new_state.input_mem = caller_state.local_mem;
+    new_state.func_ptr = fID;
+  }
+
+  void ReturnFunction() {
+    exec_stk_t & core = GetCurCore();
+    if (core.size() > 1) {
+      State & caller_state = core[core.size() - 2];
+      core.back().output_mem.ForEach([&caller_state](mem_key_t key, mem_val_t val) { caller_state.SetLocal(key, val); });
+    }
+    core.pop_back();
+  }
+
+  void SpawnCore(const affinity_t & affinity, double threshold, const memory_t & input_mem=memory_t(), bool is_main=false) {
+    if (inactive_cores.empty()) return;
+    size_t fID;
+    if (SelectFunction(affinity, threshold, fID)) SpawnCore(fID, input_mem, is_main);
+  }
+
+  void SpawnCore(size_t fID, const memory_t & input_mem=memory_t(), bool is_main=false) {
+    if (inactive_cores.empty()) return;
+    const size_t core_id = inactive_cores.back();
+    inactive_cores.pop_back();
+    used_cores = std::max(used_cores, core_id + 1);
+    exec_stk_t & core = cores[core_id];
+    core.clear();
+    State & state = core.Push(&shared_mem, is_main);
+    state.SetDefaultMemValue(default_mem_val);
+    state.input_mem = input_mem;
+    state.func_ptr = fID;
+    if (is_executing) pending_cores.push_back(core_id);
+    else active_cores.push_back(core_id);
+  }
+
+  void QueueEvent(const event_t & event) { event_queue.push_back(event); }
+  void QueueEvent(const std::string & name, const affinity_t & affinity=affinity_t(),
+                  const memory_t & msg=memory_t(), const properties_t & properties=properties_t()) {
+    event_queue.emplace_back(event_lib->GetID(name), affinity, msg, properties);
+  }
+
+  void TriggerEvent(const event_t & event) { event_lib->TriggerEvent(*this, event); }
+  void TriggerEvent(const std::string & name, const affinity_t & affinity=affinity_t(),
+                    const memory_t & msg=memory_t(), const properties_t & properties=properties_t()) {
+    event_lib->TriggerEvent(*this, event_t(event_lib->GetID(name), affinity, msg, properties));
+  }
+
+  void HandleEvent(const event_t & event) { event_lib->HandleEvent(*this, event); }
+
+  /// Handle queued events, then advance every active core by one instruction.
+  void SingleProcess() {
+    emp_assert(exec->GetSize(), "Load a program before running the hardware.");
+    if (inst_ops.size() != inst_lib->GetSize()) RefreshInstLib();
+    while (!event_queue.empty()) {
+      std::swap(event_queue, handling_events);
+      for (const event_t & event : handling_events) HandleEvent(event);
+      handling_events.clear();
+    }
+
+    is_executing = true;
+    const size_t core_cnt = active_cores.size();
+    size_t adjust = 0;
+    for (size_t active_core_idx = 0; active_core_idx < core_cnt; ++active_core_idx) {
+      exec_core_id = active_cores[active_core_idx];
+      // Keep the active cores contiguous as finished ones drop out.
+      if (adjust) {
+        active_cores[active_core_idx] = (size_t)-1;
+        active_cores[active_core_idx - adjust] = exec_core_id;
+      }
+
+      State & state = cores[exec_core_id].back();
+      const size_t fp = state.func_ptr;
+      const size_t ip = state.inst_ptr;
+      if (exec->ValidPosition(fp, ip)) {
+        ++state.inst_ptr;
+        ProcessInst(exec->GetOp(fp, ip).inst);
+      } else if (state.block_stack.size()) {
+        CloseBlock();
+      } else {
+        ReturnFunction();
+      }
+
+      if (cores[exec_core_id].empty()) {
+        active_cores[active_core_idx - adjust] = (size_t)-1;
+        inactive_cores.push_back(exec_core_id);
+        ++adjust;
+      }
+    }
+    active_cores.resize(core_cnt - adjust);
+    if (active_cores.size()) exec_core_id = active_cores[0];
+    while (pending_cores.size()) {
+      active_cores.push_back(pending_cores.front());
+      pending_cores.pop_front();
+    }
+    is_executing = false;
+  }
+
+  void Process(size_t num_steps) { for (size_t i = 0; i < num_steps; ++i) SingleProcess(); }
+
+  // Default instruction set (same behavior as emp::EventDrivenGP's).
+  static void Inst_Inc(hardware_t & hw, const inst_t & inst) { ++hw.GetCurState().AccessLocal(inst.args[0]); }
+  static void Inst_Dec(hardware_t & hw, const inst_t & inst) { --hw.GetCurState().AccessLocal(inst.args[0]); }
+  static void Inst_Not(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], state.GetLocal(inst.args[0]) == 0.0);
+  }
+  static void Inst_Add(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) + state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_Sub(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) - state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_Mult(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) * state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_Div(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    const mem_val_t denom = state.AccessLocal(inst.args[1]);
+    if (denom == 0.0) ++hw.errors;
+    else state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) / denom);
+  }
+  static void Inst_Mod(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    const int base = (int)state.AccessLocal(inst.args[1]);
+    const int num = (int)state.AccessLocal(inst.args[0]);
+    if (base == 0) ++hw.errors;
+    else state.SetLocal(inst.args[2], (mem_val_t)(static_cast<int64_t>(num) % static_cast<int64_t>(base)));
+  }
+  static void Inst_TestEqu(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) == state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_TestNEqu(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) != state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_TestLess(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) < state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_If(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    const size_t cur_ip = state.inst_ptr;
+    state.inst_ptr = hw.FindEndOfBlock(state.func_ptr, state.inst_ptr);
+    if (state.AccessLocal(inst.args[0]) == 0.0) {
+      hw.AdvanceIP(); // Skip the block.
+    } else {
+      hw.OpenBlock(cur_ip - 1, state.inst_ptr, BlockType::BASIC);
+      state.inst_ptr = cur_ip;
+    }
+  }
+  static void Inst_While(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    const size_t cur_ip = state.inst_ptr;
+    state.inst_ptr = hw.FindEndOfBlock(state.func_ptr, state.inst_ptr);
+    if (state.AccessLocal(inst.args[0]) == 0.0) {
+      hw.AdvanceIP(); // Skip the block.
+    } else {
+      hw.OpenBlock(cur_ip - 1, state.inst_ptr, BlockType::LOOP);
+      state.inst_ptr = cur_ip;
+    }
+  }
+  static void Inst_Countdown(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    const size_t cur_ip = state.inst_ptr;
+    state.inst_ptr = hw.FindEndOfBlock(state.func_ptr, state.inst_ptr);
+    if (state.AccessLocal(inst.args[0]) == 0.0) {
+      hw.AdvanceIP(); // Skip the block.
+    } else {
+      --state.AccessLocal(inst.args[0]);
+      hw.OpenBlock(cur_ip - 1, state.inst_ptr, BlockType::LOOP);
+      state.inst_ptr = cur_ip;
+    }
+  }
+  static void Inst_Close(hardware_t & hw, const inst_t &) { hw.CloseBlock(); }
+  static void Inst_Break(hardware_t & hw, const inst_t &) { hw.BreakBlock(); }
+  static void Inst_Call(hardware_t & hw, const inst_t & inst) { hw.CallFunction(inst.affinity, hw.min_bind_thresh); }
+  static void Inst_Return(hardware_t & hw, const inst_t &) { hw.ReturnFunction(); }
+  static void Inst_SetMem(hardware_t & hw, const inst_t & inst) {
+    hw.GetCurState().SetLocal(inst.args[0], (mem_val_t)inst.args[1]);
+  }
+  static void Inst_CopyMem(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[1], state.AccessLocal(inst.args[0]));
+  }
+  static void Inst_SwapMem(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    const mem_val_t val0 = state.AccessLocal(inst.args[0]);
+    state.SetLocal(inst.args[0], state.AccessLocal(inst.args[1]));
+    state.SetLocal(inst.args[1], val0);
+  }
+  static void Inst_Input(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[1], state.AccessInput(inst.args[0]));
+  }
+  static void Inst_Output(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetOutput(inst.args[1], state.AccessLocal(inst.args[0]));
+  }
+  static void Inst_Commit(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    hw.SetShared(inst.args[1], state.AccessLocal(inst.args[0]));
+  }
+  static void Inst_Pull(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[1], hw.AccessShared(inst.args[0]));
+  }
+  static void Inst_Nop(hardware_t &, const inst_t &) { ; }
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef COUNTER_RANDOM_H
+#define COUNTER_RANDOM_H
+
+#include <cstdint>
+
+#include "base/assert.h"
+
+/// Counter-based random number stream (SplitMix64 finalizer over a keyed counter).
+/// A stream is fully determined by its key, so the numbers a game sees depend only on
+/// (seed, update, agent, game) and not on which thread plays it or when.
+class CounterRandom {
+
+protected:
+  static constexpr uint64_t GAMMA = 0x9e3779b97f4a7c15ULL;
+
+  uint64_t key;
+  uint64_t counter;
+
+  static uint64_t Mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  uint64_t Next() { return Mix(key + (++counter) * GAMMA); }
+
+public:
+  CounterRandom(uint64_t seed=0) : key(0), counter(0) { Reset(seed); }
+
+  /// Start the stream identified by seed and any number of counters (update, agent, game...).
+  void Reset(uint64_t seed) { key = Mix(seed + GAMMA); counter = 0; }
+  template <typename... Ts>
+  void Reset(uint64_t seed, uint64_t id, Ts... ids) {
+    Reset(seed);
+    Reset(key ^ id, ids...);
+  }
+
+  /// Uniform double in [0, 1).
+  double GetDouble() { return (Next() >> 11) * (1.0 / 9007199254740992.0); }
+
+  /// Uniform integer in [0, max).
+  size_t GetUInt(size_t max) { return (size_t)(GetDouble() * max); }
+  /// Uniform integer in [min, max).
+  size_t GetUInt(size_t min, size_t max) { emp_assert(min <= max); return min + GetUInt(max - min); }
+  /// Uniform integer in [min, max).
+  int GetInt(int min, int max) { emp_assert(min <= max); return min + (int)GetUInt((size_t)(max - min)); }
+
+  /// Positive seed suitable for an emp::Random that should follow this stream.
+  int GetSeed() { return GetInt(1, 2147483647); }
+};
+
+#endif
@@ -41,7 +41,7 @@ void EnsembleExp::ConfigSGP_InstLib() {
                         1, "WM[ARG1] = Othello board width");
   sgp_inst_lib->AddInst("EndTurn",
                         [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP_Inst_EndTurn(hw, inst); },
-                        0, "End current othello turn");
+                        0, "End current othello turn", emp::ScopeType::BASIC, 0, {"halt"});
   sgp_inst_lib->AddInst("SetMoveXY",
                         [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_SetMoveXY(hw, inst); },
                         2, "MoveXY = (WM[ARG1], WM[ARG2])");
@@ -174,7 +174,7 @@ void EnsembleExp::ConfigCoordinatorLib()
   coord_inst_lib->AddInst("Nop", SGP__hardware_t::Inst_Nop, 0, "No operation.");
   coord_inst_lib->AddInst("EndTurn",
                         [this](SGP__hardware_t &hw, const SGP__inst_t &inst) { this->SGP_Inst_EndTurn(hw, inst); },
-                        0, "End current othello turn");
+                        0, "End current othello turn", emp::ScopeType::BASIC, 0, {"halt"});
   coord_inst_lib->AddInst("SetMoveXY",
                         [this](SGP__hardware_t &hw, const SGP__inst_t &inst) { this->SGP__Inst_SetMoveXY(hw, inst); },
                         2, "MoveXY = (WM[ARG1], WM[ARG2])");
@@ -208,10 +208,11 @@ void EnsembleExp::Inst_GetFace(SGP__hardware_t &hw, const SGP__inst_t &inst)
 
 void EnsembleExp::SGP__Inst_CastVote(SGP__hardware_t &hw, const SGP__inst_t &inst)
 {
+  EvalWorker & worker = *GetEvalContext(hw).worker;
   othello_idx_t move = GetOthelloIndex((size_t)hw.GetTrait(TRAIT_ID__MOVE));
   hw.SetTrait(TRAIT_ID__CAST, hw.GetTrait(TRAIT_ID__CAST) + 1);
 
-  if (!game_hw->IsValidMove(game_hw->GetCurPlayer(), move)) 
+  if (!worker.game_hw->IsValidMove(worker.game_hw->GetCurPlayer(), move)) 
   {
     hw.SetTrait(TRAIT_ID__INVALID, hw.GetTrait(TRAIT_ID__INVALID) + 1);
     return;
@@ -221,11 +222,11 @@ void EnsembleExp::SGP__Inst_CastVote(SGP__hardware_t &hw, const SGP__inst_t &ins
   const size_t loc = hw.GetTrait(TRAIT_ID__LOC);
   //std::cout<<"Casting... Vote: "<<move.pos<<" Confidence: "<<confidence<<std::endl;
   
-  if (coordinator_id >= 0)
+  if (worker.coordinator_id >= 0)
   {
-    if (loc == coordinator_id)
+    if (loc == worker.coordinator_id)
     {
-      agent_votes[move.pos] += confidence;
+      worker.agent_votes[move.pos] += confidence;
     }
     else
     {
@@ -236,17 +237,17 @@ void EnsembleExp::SGP__Inst_CastVote(SGP__hardware_t &hw, const SGP__inst_t &ins
           //std::cout<<"Already cast vote. Returning..."<<std::endl;
           return;
         }
-        othello_idx_t heur_real = heuristics[loc - 1]();
-        if(move.pos == heur_real.pos) h_choices[move.pos] += confidence;
-        //std::cout<<"Confidence: "<<confidence<<" Move: "<<move.pos<<" HCHOICES: "<<h_choices[move.pos]<<" Loc: "<<loc<<std::endl;
+        othello_idx_t heur_real = heuristics[loc - 1](worker);
+        if(move.pos == heur_real.pos) worker.h_choices[move.pos] += confidence;
+        //std::cout<<"Confidence: "<<confidence<<" Move: "<<move.pos<<" HCHOICES: "<<worker.h_choices[move.pos]<<" Loc: "<<loc<<std::endl;
       }
     }
 
   }
   else
   {
-    agent_votes[move.pos] += confidence;
-    //std::cout<<"Agent votes at move pos: "<<agent_votes[move.pos]<<std::endl;
+    worker.agent_votes[move.pos] += confidence;
+    //std::cout<<"Agent votes at move pos: "<<worker.agent_votes[move.pos]<<std::endl;
   }
 }
 
@@ -273,7 +274,7 @@ void EnsembleExp::EventDriven__DispatchMessageFacing(SGP__hardware_t &hw, const
   //const size_t loc = (size_t)hw.GetTrait(TRAIT_ID__LOC);
   //emp_assert(GROUP_SIZE > 1); // cant mod by 0
   const size_t facing_id = emp::Mod(hw.GetTrait(TRAIT_ID__GID), GROUP_SIZE); //emp::Mod(loc + 1 + emp::Mod(hw.GetTrait(TRAIT_ID__GID), GROUP_SIZE - 1), GROUP_SIZE); // Can get all group ids except own TODO
-  sgpg_eval_hw[facing_id]->QueueEvent(event);
+  GetEvalContext(hw).worker->sgpg_eval_hw[facing_id]->QueueEvent(event);
 }
 
 /// Dispatch to all of hw's neighbors.
@@ -284,7 +285,7 @@ void EnsembleExp::EventDriven__DispatchMessageBroadcast(SGP__hardware_t &hw, con
   for (size_t i = 1; i < GROUP_SIZE; ++i)
   {
     size_t facing_id = emp::Mod(hw.GetTrait(TRAIT_ID__LOC) + i, GROUP_SIZE); // Can get all group ids except own
-    sgpg_eval_hw[facing_id]->QueueEvent(event);
+    GetEvalContext(hw).worker->sgpg_eval_hw[facing_id]->QueueEvent(event);
   }
 }
 
@@ -356,9 +357,10 @@ void EnsembleExp::SGP__Inst_GetMoveID(SGP__hardware_t & hw, const SGP__inst_t &
 }
 // SGP__Inst_IsValidXY
 void EnsembleExp::SGP__Inst_IsValidXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   const size_t move_x = state.GetLocal(inst.args[0]);
   const size_t move_y = state.GetLocal(inst.args[1]);
   const int valid = (int)dreamboard.IsValidMove(playerID, {move_x, move_y});
@@ -366,18 +368,20 @@ void EnsembleExp::SGP__Inst_IsValidXY_HW(SGP__hardware_t & hw, const SGP__inst_t
 }
 // SGP__Inst_IsValidID_HW
 void EnsembleExp::SGP__Inst_IsValidID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   const size_t move_id = state.GetLocal(inst.args[0]);
   const int valid = (int)dreamboard.IsValidMove(playerID, GetOthelloIndex(move_id));
   state.SetLocal(inst.args[1], valid);
 }
 // SGP__Inst_IsValidOppXY
 void EnsembleExp::SGP__Inst_IsValidOppXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   const player_t oppID = dreamboard.GetOpponent(playerID);
   const size_t move_x = state.GetLocal(inst.args[0]);
   const size_t move_y = state.GetLocal(inst.args[1]);
@@ -386,9 +390,10 @@ void EnsembleExp::SGP__Inst_IsValidOppXY_HW(SGP__hardware_t & hw, const SGP__ins
 }
 // SGP__Inst_IsValidOppID
 void EnsembleExp::SGP__Inst_IsValidOppID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   const player_t oppID = dreamboard.GetOpponent(playerID);
   const size_t move_id = state.GetLocal(inst.args[0]);
   const int valid = (int)dreamboard.IsValidMove(oppID, GetOthelloIndex(move_id));
@@ -396,8 +401,9 @@ void EnsembleExp::SGP__Inst_IsValidOppID_HW(SGP__hardware_t & hw, const SGP__ins
 }
 // SGP__Inst_AdjacentXY
 void EnsembleExp::SGP__Inst_AdjacentXY(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   const size_t move_x = (size_t)state.GetLocal(inst.args[0]);
   const size_t move_y = (size_t)state.GetLocal(inst.args[1]);
   const facing_t dir  = IntToFacing(state.GetLocal(inst.args[2]));
@@ -412,8 +418,9 @@ void EnsembleExp::SGP__Inst_AdjacentXY(SGP__hardware_t & hw, const SGP__inst_t &
 }
 // SGP__Inst_AdjacentID
 void EnsembleExp::SGP__Inst_AdjacentID(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   const size_t move_id = (size_t)state.GetLocal(inst.args[0]);
   const facing_t dir = IntToFacing(state.GetLocal(inst.args[1]));
   const othello_idx_t neighbor = dreamboard.GetNeighbor(GetOthelloIndex(move_id), dir);
@@ -421,27 +428,30 @@ void EnsembleExp::SGP__Inst_AdjacentID(SGP__hardware_t & hw, const SGP__inst_t &
 }
 // SGP_Inst_ValidMoveCnt_HW
 void EnsembleExp::SGP__Inst_ValidMoveCnt_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   state.SetLocal(inst.args[0], dreamboard.GetMoveOptions(playerID).size());
 }
 // SGP_Inst_ValidOppMoveCnt_HW
 void EnsembleExp::SGP__Inst_ValidOppMoveCnt_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   const player_t oppID = dreamboard.GetOpponent(playerID);
   state.SetLocal(inst.args[0], dreamboard.GetMoveOptions(oppID).size());
 }
 // SGP_Inst_GetBoardValueXY_HW
 void EnsembleExp::SGP__Inst_GetBoardValueXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   const size_t move_x = state.GetLocal(inst.args[0]);
   const size_t move_y = state.GetLocal(inst.args[1]);
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   const player_t oppID = dreamboard.GetOpponent(playerID);
   // If inputs are garbage, let the caller know.
   if (move.IsValid()) {
@@ -455,11 +465,12 @@ void EnsembleExp::SGP__Inst_GetBoardValueXY_HW(SGP__hardware_t & hw, const SGP__
 }
 // SGP_Inst_GetBoardValueID_HW
 void EnsembleExp::SGP__Inst_GetBoardValueID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   const size_t move_id = state.GetLocal(inst.args[0]);
   const othello_idx_t move(GetOthelloIndex(move_id));
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   const player_t oppID = dreamboard.GetOpponent(playerID);
   // If inputs are garbage, let the caller know.
   if (move.IsValid()) {
@@ -473,12 +484,13 @@ void EnsembleExp::SGP__Inst_GetBoardValueID_HW(SGP__hardware_t & hw, const SGP__
 }
 // SGP_Inst_PlaceDiskXY_HW
 void EnsembleExp::SGP__Inst_PlaceDiskXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   const size_t move_x = (size_t)state.GetLocal(inst.args[0]);
   const size_t move_y = (size_t)state.GetLocal(inst.args[1]);
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   if (dreamboard.IsValidMove(playerID, move)) {
     dreamboard.DoMove(playerID, move);
     state.SetLocal(inst.args[2], 1);
@@ -488,10 +500,11 @@ void EnsembleExp::SGP__Inst_PlaceDiskXY_HW(SGP__hardware_t & hw, const SGP__inst
 }
 // SGP_Inst_PlaceDiskID_HW
 void EnsembleExp::SGP__Inst_PlaceDiskID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   const othello_idx_t move = GetOthelloIndex(state.GetLocal(inst.args[0]));
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   if (dreamboard.IsValidMove(playerID, move)) {
     dreamboard.DoMove(playerID, move);
     state.SetLocal(inst.args[1], 1);
@@ -501,12 +514,13 @@ void EnsembleExp::SGP__Inst_PlaceDiskID_HW(SGP__hardware_t & hw, const SGP__inst
 }
 // SGP_Inst_PlaceOppDiskXY_HW
 void EnsembleExp::SGP__Inst_PlaceOppDiskXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   const size_t move_x = (size_t)state.GetLocal(inst.args[0]);
   const size_t move_y = (size_t)state.GetLocal(inst.args[1]);
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   const player_t oppID = dreamboard.GetOpponent(playerID);
   if (dreamboard.IsValidMove(oppID, move)) {
     dreamboard.DoMove(oppID, move);
@@ -517,10 +531,11 @@ void EnsembleExp::SGP__Inst_PlaceOppDiskXY_HW(SGP__hardware_t & hw, const SGP__i
 }
 // SGP_Inst_PlaceOppDiskID_HW
 void EnsembleExp::SGP__Inst_PlaceOppDiskID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   const othello_idx_t move = GetOthelloIndex(state.GetLocal(inst.args[0]));
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   const player_t oppID = dreamboard.GetOpponent(playerID);
   if (dreamboard.IsValidMove(oppID, move)) {
     dreamboard.DoMove(oppID, move);
@@ -531,12 +546,13 @@ void EnsembleExp::SGP__Inst_PlaceOppDiskID_HW(SGP__hardware_t & hw, const SGP__i
 }
 // SGP_Inst_FlipCntXY_HW
 void EnsembleExp::SGP__Inst_FlipCntXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   const size_t move_x = (size_t)state.GetLocal(inst.args[0]);
   const size_t move_y = (size_t)state.GetLocal(inst.args[1]);
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   if (dreamboard.IsValidMove(playerID, move)) {
     state.SetLocal(inst.args[2], dreamboard.GetFlipCount(playerID, move));
   } else {
@@ -545,10 +561,11 @@ void EnsembleExp::SGP__Inst_FlipCntXY_HW(SGP__hardware_t & hw, const SGP__inst_t
 }
 // SGP_Inst_FlipCntID_HW
 void EnsembleExp::SGP__Inst_FlipCntID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   const othello_idx_t move = GetOthelloIndex((size_t)state.GetLocal(inst.args[0]));
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   if (dreamboard.IsValidMove(playerID, move)) {
     state.SetLocal(inst.args[1], dreamboard.GetFlipCount(playerID, move));
   } else {
@@ -557,12 +574,13 @@ void EnsembleExp::SGP__Inst_FlipCntID_HW(SGP__hardware_t & hw, const SGP__inst_t
 }
 // SGP_Inst_OppFlipCntXY_HW
 void EnsembleExp::SGP__Inst_OppFlipCntXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   const size_t move_x = (size_t)state.GetLocal(inst.args[0]);
   const size_t move_y = (size_t)state.GetLocal(inst.args[1]);
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   const player_t oppID = dreamboard.GetOpponent(playerID);
   if (dreamboard.IsValidMove(oppID, move)) {
     state.SetLocal(inst.args[2], dreamboard.GetFlipCount(oppID, move));
@@ -572,10 +590,11 @@ void EnsembleExp::SGP__Inst_OppFlipCntXY_HW(SGP__hardware_t & hw, const SGP__ins
 }
 // SGP_Inst_OppFlipCntID_HW
 void EnsembleExp::SGP__Inst_OppFlipCntID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   const othello_idx_t move = GetOthelloIndex((size_t)state.GetLocal(inst.args[0]));
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   const player_t oppID = dreamboard.GetOpponent(playerID);
   if (dreamboard.IsValidMove(oppID, move)) {
     state.SetLocal(inst.args[1], dreamboard.GetFlipCount(oppID, move));
@@ -585,19 +604,22 @@ void EnsembleExp::SGP__Inst_OppFlipCntID_HW(SGP__hardware_t & hw, const SGP__ins
 }
 // SGP_Inst_FrontierCnt_HW
 void EnsembleExp::SGP__Inst_FrontierCnt_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
+  const player_t playerID = ctx.dreamware->GetPlayerID();
   state.SetLocal(inst.args[0], dreamboard.CountFrontierPos(playerID));
 }
 // // SGP_Inst_ResetBoard_HW
 void EnsembleExp::SGP__Inst_ResetBoard_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  othello_dreamware->ResetActive(*game_hw);
+  const EvalContext & ctx = GetEvalContext(hw);
+  ctx.dreamware->ResetActive(*ctx.worker->game_hw);
 }
 // SGP_Inst_IsOver_HW
 void EnsembleExp::SGP__Inst_IsOver_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+  const EvalContext & ctx = GetEvalContext(hw);
   SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+  othello_t & dreamboard = ctx.dreamware->GetActiveDreamOthello();
   state.SetLocal(inst.args[0], (int)dreamboard.IsOver());
 }
 
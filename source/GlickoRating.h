@@ -0,0 +1,120 @@
+#ifndef GLICKO_RATING_H
+#define GLICKO_RATING_H
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "base/assert.h"
+#include "base/vector.h"
+
+/// Glicko-1 ratings for a pool of players whose strength doesn't change (e.g. saved programs).
+/// Results are collected over a rating period and applied together by EndPeriod, and
+/// GetPairings picks the games that should shrink the rating deviations the most.
+class GlickoRating {
+public:
+  struct Player {
+    double rating;    ///< Estimated strength (Elo scale).
+    double deviation; ///< Uncertainty of rating (one standard deviation).
+    size_t games;     ///< Games included so far.
+  };
+
+protected:
+  static constexpr double PI = 3.14159265358979323846;
+  static constexpr double Q = 0.0057564627324851142; ///< ln(10) / 400
+
+  struct Result {
+    size_t opp;
+    double points; ///< 1 win, 0.5 tie, 0 loss.
+  };
+
+  emp::vector<Player> players;
+  emp::vector<emp::vector<Result>> period_results; ///< Results of the current period, per player.
+
+  /// Weight of a game against an opponent with deviation opp_rd.
+  static double G(double opp_rd) { return 1.0 / std::sqrt(1.0 + 3.0 * Q * Q * opp_rd * opp_rd / (PI * PI)); }
+
+public:
+  GlickoRating(size_t count=0, double rating=1500.0, double deviation=350.0)
+    : players(count, Player{rating, deviation, 0}), period_results(count) { ; }
+
+  size_t GetSize() const { return players.size(); }
+  const Player & Get(size_t id) const { return players[id]; }
+
+  double GetMaxDeviation() const {
+    double max_rd = 0.0;
+    for (const Player & player : players) max_rd = std::max(max_rd, player.deviation);
+    return max_rd;
+  }
+
+  /// Expected points of id against opp.
+  double GetExpected(size_t id, size_t opp) const {
+    const double g = G(players[opp].deviation);
+    return 1.0 / (1.0 + std::pow(10.0, -g * (players[id].rating - players[opp].rating) / 400.0));
+  }
+
+  /// Fisher information one game against opp gives about the rating of id.
+  double GetInformation(size_t id, size_t opp) const {
+    const double g = G(players[opp].deviation);
+    const double e = GetExpected(id, opp);
+    return Q * Q * g * g * e * (1.0 - e);
+  }
+
+  /// Record a game for the current period; points are id's (1 win, 0.5 tie, 0 loss).
+  void AddResult(size_t id, size_t opp, double points) {
+    emp_assert(id != opp && points >= 0.0 && points <= 1.0);
+    period_results[id].push_back({opp, points});
+    period_results[opp].push_back({id, 1.0 - points});
+  }
+
+  /// Update every rating from the results recorded since the last period ended.
+  void EndPeriod() {
+    emp::vector<Player> next = players;
+    for (size_t id = 0; id < players.size(); ++id) {
+      if (period_results[id].empty()) continue;
+      double info = 0.0, delta = 0.0;
+      for (const Result & result : period_results[id]) {
+        info += GetInformation(id, result.opp);
+        delta += G(players[result.opp].deviation) * (result.points - GetExpected(id, result.opp));
+      }
+      const double precision = 1.0 / (players[id].deviation * players[id].deviation) + info;
+      next[id].rating += Q / precision * delta;
+      next[id].deviation = std::sqrt(1.0 / precision);
+      next[id].games += period_results[id].size();
+      period_results[id].clear();
+    }
+    players = next;
+  }
+
+  /// Pair off players for the next period, each at most once: the most uncertain player left
+  /// meets the opponent that would take the most variance out of both their ratings.
+  /// Players whose deviation is already below min_deviation only serve as opponents.
+  emp::vector<std::pair<size_t, size_t>> GetPairings(double min_deviation) const {
+    emp::vector<std::pair<size_t, size_t>> pairings;
+    emp::vector<bool> paired(players.size(), false);
+    while (true) {
+      size_t id = players.size();
+      for (size_t i = 0; i < players.size(); ++i) {
+        if (paired[i] || players[i].deviation < min_deviation) continue;
+        if (id == players.size() || players[i].deviation > players[id].deviation) id = i;
+      }
+      if (id == players.size()) break;
+
+      size_t opp = players.size();
+      double best_gain = -1.0;
+      for (size_t j = 0; j < players.size(); ++j) {
+        if (paired[j] || j == id) continue;
+        const double rd_id = players[id].deviation, rd_j = players[j].deviation;
+        const double gain = rd_id * rd_id * GetInformation(id, j) + rd_j * rd_j * GetInformation(j, id);
+        if (gain > best_gain) { best_gain = gain; opp = j; }
+      }
+      if (opp == players.size()) break;
+
+      paired[id] = paired[opp] = true;
+      pairings.emplace_back(id, opp);
+    }
+    return pairings;
+  }
+};
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef OTHELLO_BITBOARD_H
+#define OTHELLO_BITBOARD_H
+
+#include <iostream>
+#include <cstdint>
+
+#include "base/assert.h"
+#include "base/vector.h"
+
+/// 8x8 Othello on two 64-bit masks (bit y*8+x is cell (x,y)). Drop-in replacement for
+/// emp::Othello8: same types, positions, move order and end-of-game rules, but move
+/// generation, flips and scores are shifts, masks and popcounts.
+class OthelloBitboard {
+public:
+  static constexpr size_t BOARD_SIZE = 8;
+  static constexpr size_t NUM_CELLS = 64;
+  static constexpr size_t NUM_DIRECTIONS = 8;
+
+  enum Player { NONE = 0, DARK, LIGHT };
+  enum Facing { N = 0, NE, E, SE, S, SW, W, NW };
+
+  struct Index {
+    size_t pos;
+
+    Index() : pos(NUM_CELLS) { ; }
+    Index(size_t _pos) : pos(_pos) { ; }
+    Index(size_t x, size_t y) : pos(NUM_CELLS) { Set(x, y); }
+
+    operator size_t() const { return pos; }
+    size_t x() const { return pos % BOARD_SIZE; }
+    size_t y() const { return pos / BOARD_SIZE; }
+    void Set(size_t x, size_t y) { pos = (x < BOARD_SIZE && y < BOARD_SIZE) ? (y * BOARD_SIZE + x) : NUM_CELLS; }
+    bool IsValid() const { return pos < NUM_CELLS; }
+
+    Index CalcNeighbor(Facing dir) const {
+      if (!IsValid()) return Index();
+      const uint64_t n = Shift(ToMask(pos), dir);
+      return n ? Index(Ctz(n)) : Index();
+    }
+  };
+
+  /// Full board state, as handed between boards by GetBoard/SetBoard.
+  struct board_t {
+    uint64_t dark;
+    uint64_t light;
+  };
+
+protected:
+  static constexpr uint64_t NOT_FILE_A = 0xfefefefefefefefeULL; ///< Every cell except x == 0.
+  static constexpr uint64_t NOT_FILE_H = 0x7f7f7f7f7f7f7f7fULL; ///< Every cell except x == 7.
+
+  board_t board;
+  Player cur_player;
+  bool over;
+
+  static uint64_t ToMask(size_t pos) { return ((uint64_t)1) << pos; }
+  static size_t Ctz(uint64_t bits) { return (size_t)__builtin_ctzll(bits); }
+  static size_t PopCount(uint64_t bits) { return (size_t)__builtin_popcountll(bits); }
+
+  /// Move every cell of bits one step in direction dir, dropping cells that leave the board.
+  static uint64_t Shift(uint64_t bits, Facing dir) {
+    switch (dir) {
+      case N:  return bits >> 8;
+      case NE: return (bits >> 7) & NOT_FILE_A;
+      case E:  return (bits << 1) & NOT_FILE_A;
+      case SE: return (bits << 9) & NOT_FILE_A;
+      case S:  return bits << 8;
+      case SW: return (bits << 7) & NOT_FILE_H;
+      case W:  return (bits >> 1) & NOT_FILE_H;
+      case NW: return (bits >> 9) & NOT_FILE_H;
+    }
+    return 0;
+  }
+
+  uint64_t GetMask(Player player) const { return (player == DARK) ? board.dark : board.light; }
+  uint64_t GetEmptyMask() const { return ~(board.dark | board.light); }
+
+  /// Mask of every empty cell where player could move.
+  uint64_t GetMoveMask(Player player) const {
+    const uint64_t own = GetMask(player);
+    const uint64_t opp = GetMask(GetOpponent(player));
+    uint64_t moves = 0;
+    for (size_t d = 0; d < NUM_DIRECTIONS; ++d) {
+      const Facing dir = (Facing)d;
+      uint64_t run = Shift(own, dir) & opp;
+      for (size_t i = 0; i < BOARD_SIZE - 3; ++i) run |= Shift(run, dir) & opp;
+      moves |= Shift(run, dir);
+    }
+    return moves & GetEmptyMask();
+  }
+
+  /// Mask of the disks player would flip by moving at pos.
+  uint64_t GetFlipMask(Player player, Index pos) const {
+    const uint64_t own = GetMask(player);
+    const uint64_t opp = GetMask(GetOpponent(player));
+    uint64_t flips = 0;
+    for (size_t d = 0; d < NUM_DIRECTIONS; ++d) {
+      const Facing dir = (Facing)d;
+      uint64_t run = 0;
+      uint64_t cur = Shift(ToMask(pos), dir);
+      while (cur & opp) { run |= cur; cur = Shift(cur, dir); }
+      if (cur & own) flips |= run;
+    }
+    return flips;
+  }
+
+  static emp::vector<Index> ToIndices(uint64_t bits) {
+    emp::vector<Index> out;
+    out.reserve(PopCount(bits));
+    for (; bits; bits &= bits - 1) out.emplace_back(Ctz(bits));
+    return out;
+  }
+
+public:
+  OthelloBitboard() { Reset(); }
+
+  void Reset() {
+    board.dark = ToMask(Index(4, 3)) | ToMask(Index(3, 4));
+    board.light = ToMask(Index(3, 3)) | ToMask(Index(4, 4));
+    cur_player = DARK;
+    over = false;
+  }
+
+  static Player GetOpponent(Player player) {
+    return (player == DARK) ? LIGHT : ((player == LIGHT) ? DARK : NONE);
+  }
+
+  Player GetCurPlayer() const { return cur_player; }
+  const board_t & GetBoard() const { return board; }
+  Index GetNeighbor(Index pos, Facing dir) const { return pos.CalcNeighbor(dir); }
+
+  Player GetPosOwner(Index pos) const {
+    emp_assert(pos.IsValid());
+    const uint64_t bit = ToMask(pos);
+    if (board.dark & bit) return DARK;
+    if (board.light & bit) return LIGHT;
+    return NONE;
+  }
+
+  void SetBoard(const board_t & other) { board = other; }
+  void SetCurPlayer(Player player) { cur_player = player; }
+
+  void SetPos(Index pos, Player player) {
+    emp_assert(pos.IsValid());
+    const uint64_t bit = ToMask(pos);
+    board.dark &= ~bit;
+    board.light &= ~bit;
+    if (player == DARK) board.dark |= bit;
+    else if (player == LIGHT) board.light |= bit;
+  }
+
+  emp::vector<Index> GetMoveOptions(Player player) const { return ToIndices(GetMoveMask(player)); }
+  emp::vector<Index> GetMoveOptions() const { return GetMoveOptions(cur_player); }
+  bool HasMoveOptions(Player player) const { return GetMoveMask(player) != 0; }
+
+  emp::vector<Index> GetFlipList(Player player, Index pos) const {
+    if (!pos.IsValid()) return emp::vector<Index>();
+    return ToIndices(GetFlipMask(player, pos));
+  }
+
+  size_t GetFlipCount(Player player, Index pos) const {
+    if (!pos.IsValid()) return 0;
+    return PopCount(GetFlipMask(player, pos));
+  }
+
+  bool IsValidMove(Player player, Index pos) const {
+    if (!pos.IsValid() || !(GetEmptyMask() & ToMask(pos))) return false;
+    return GetFlipMask(player, pos) != 0;
+  }
+
+  /// Number of player's disks next to at least one empty cell.
+  size_t CountFrontierPos(Player player) const {
+    const uint64_t empty = GetEmptyMask();
+    uint64_t near_empty = 0;
+    for (size_t d = 0; d < NUM_DIRECTIONS; ++d) near_empty |= Shift(empty, (Facing)d);
+    return PopCount(near_empty & GetMask(player));
+  }
+
+  /// Place a disk for player at pos and flip everything it captures.
+  /// Returns whether player goes again (i.e. the opponent has no moves).
+  bool DoMove(Player player, Index pos) {
+    emp_assert(pos.IsValid());
+    emp_assert(player == DARK || player == LIGHT);
+    const uint64_t flipped = GetFlipMask(player, pos) | ToMask(pos);
+    if (player == DARK) { board.dark |= flipped; board.light &= ~flipped; }
+    else { board.light |= flipped; board.dark &= ~flipped; }
+
+    if (HasMoveOptions(GetOpponent(player))) return false;
+    if (!HasMoveOptions(player)) over = true;
+    return true;
+  }
+
+  /// Do a move for the current player and hand the turn over if the opponent can move.
+  bool DoNextMove(Index pos) {
+    const bool go_again = DoMove(cur_player, pos);
+    if (!go_again) cur_player = GetOpponent(cur_player);
+    return go_again;
+  }
+
+  bool IsOver() const { return over; }
+
+  double GetScore(Player player) const { return (double)PopCount(GetMask(player)); }
+
+  void Print(std::ostream & os=std::cout, char dark='D', char light='L', char open='O') const {
+    for (size_t y = 0; y < BOARD_SIZE; ++y) {
+      for (size_t x = 0; x < BOARD_SIZE; ++x) {
+        const Player owner = GetPosOwner(Index(x, y));
+        os << ((owner == DARK) ? dark : ((owner == LIGHT) ? light : open)) << ' ';
+      }
+      os << std::endl;
+    }
+  }
+};
+
+#endif
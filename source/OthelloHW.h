@@ -6,12 +6,21 @@
 #include "tools/random_utils.h"
 #include "tools/math.h"
 #include "tools/string_utils.h"
+#include "OthelloBitboard.h"
+
+// Othello engine used for game boards and dreams. Build with -DENSEMBLE_BITBOARD_OTHELLO
+// to use the bitboard engine instead of emp::Othello8.
+#ifdef ENSEMBLE_BITBOARD_OTHELLO
+using othello_engine_t = OthelloBitboard;
+#else
+using othello_engine_t = emp::Othello8;
+#endif
 
 // NOTE: we don't actually need this for test case evaluations...
 class OthelloHardware {
 
 protected:
-  using othello_t = emp::Othello8;
+  using othello_t = othello_engine_t;
   using player_t = othello_t::Player;
   emp::vector<othello_t> dreams; ///< Let's lean into that whole 'othello dream' terminology...
   size_t active_dream;
@@ -0,0 +1,74 @@
+#ifndef REGISTER_FILE_H
+#define REGISTER_FILE_H
+
+#include <bitset>
+#include <cstdint>
+#include <unordered_map>
+
+#include "base/array.h"
+
+/// SignalGP memory (int keys, double values) that keeps keys 0 to SIZE-1 in a fixed array and
+/// any other key in a map, so the registers programs address are never hashed and copying a
+/// memory is a flat copy. As in the map it replaces, a key only exists once it has been set
+/// or accessed, and iteration (ForEach) only visits keys that exist.
+template <size_t SIZE>
+class RegisterFile {
+public:
+  using key_t = int;
+  using value_t = double;
+
+  static_assert(SIZE <= 64, "RegisterFile tracks its registers with a 64-bit mask.");
+
+protected:
+  emp::array<value_t, SIZE> regs;
+  uint64_t used;                              ///< Bit k is set once register k exists.
+  std::unordered_map<key_t, value_t> others;  ///< Keys outside [0, SIZE).
+
+  static bool IsRegister(key_t key) { return key >= 0 && (size_t)key < SIZE; }
+  static uint64_t Bit(key_t key) { return ((uint64_t)1) << key; }
+
+public:
+  RegisterFile() : regs(), used(0), others() { ; }
+
+  size_t size() const { return std::bitset<64>(used).count() + others.size(); }
+  bool empty() const { return !used && others.empty(); }
+  void clear() { used = 0; if (others.size()) others.clear(); }
+
+  bool Has(key_t key) const { return IsRegister(key) ? (used & Bit(key)) : others.count(key); }
+
+  /// Value at key, or default_val if key doesn't exist.
+  value_t Get(key_t key, value_t default_val) const {
+    if (IsRegister(key)) return (used & Bit(key)) ? regs[key] : default_val;
+    auto it = others.find(key);
+    return (it == others.end()) ? default_val : it->second;
+  }
+
+  /// Value at key, which is created with default_val if it doesn't exist yet.
+  value_t & Access(key_t key, value_t default_val) {
+    if (!IsRegister(key)) return others.emplace(key, default_val).first->second;
+    if (!(used & Bit(key))) {
+      regs[key] = default_val;
+      used |= Bit(key);
+    }
+    return regs[key];
+  }
+
+  void Set(key_t key, value_t val) {
+    if (!IsRegister(key)) { others[key] = val; return; }
+    regs[key] = val;
+    used |= Bit(key);
+  }
+
+  value_t & operator[](key_t key) { return Access(key, 0.0); }
+
+  /// Call fun(key, value) for every key that exists: registers in order, then the others.
+  template <typename FUN>
+  void ForEach(FUN fun) const {
+    for (key_t key = 0; (size_t)key < SIZE && (used >> key); ++key) {
+      if (used & Bit(key)) fun(key, regs[key]);
+    }
+    for (const auto & mem : others) fun(mem.first, mem.second);
+  }
+};
+
+#endif
@@ -20,7 +20,23 @@ EMP_BUILD_CONFIG( EnsembleConfig,
   VALUE(COMPETE_TYPE, size_t, 0, "What program types are competing? \n0: Individual Only \n1: Individual vs Ensemble \n2: Ensemble Only"),
   VALUE(COMPETE_FPATH_1, std::string, "./compete_1.gp", "Program 1 to load to compete"),
   VALUE(COMPETE_FPATH_2, std::string, "./compete_2.gp", "Program 2 to load to compete"),
+  VALUE(NUM_COMPETE_GAMES, size_t, 1, "How many games does the ANCESTOR_FPATH program(s) play against the Minimax AI? More than one alternates colors and writes every game to COMPETE_OUTPUT"),
+  VALUE(COMPETE_OPENING_MOVES, size_t, 0, "How many random moves open each pair of NUM_COMPETE_GAMES games? (both games of a pair play the same opening, with colors swapped)"),
+  VALUE(COMPETE_MANIFEST, std::string, "", "If set, play every pairing in this file in one run (lines of two competitors: 'ai', 'individual <path>' or 'ensemble <path>')"),
+  VALUE(COMPETE_OUTPUT, std::string, "./compete_results.csv", "CSV file the games of NUM_COMPETE_GAMES, COMPETE_MANIFEST or COMPETE_RATING_POOL are written to"),
+  VALUE(COMPETE_RATING_POOL, std::string, "", "If set, rate every competitor in this file (one per line, as in COMPETE_MANIFEST) against each other"),
+  VALUE(COMPETE_RATING_RD, double, 50.0, "Stop rating once every rating deviation is below this"),
+  VALUE(COMPETE_RATING_GAMES, size_t, 100000, "Stop rating after this many games"),
+  VALUE(COMPETE_RATING_OUTPUT, std::string, "./ratings.csv", "CSV file COMPETE_RATING_POOL ratings are written to"),
+  VALUE(COMPETE_SERVER, std::string, "", "If set, stay running and answer match requests, one per line: '-' reads them from stdin, anything else is the unix socket to listen on"),
+  VALUE(COMPETE_KO_MATRIX, std::string, "", "If set, play every agent and instruction knockout of the ANCESTOR_FPATH program(s) against the Minimax AI and write the results per knockout to this CSV file"),
+  VALUE(COMPETE_KO_GAMES, size_t, 100, "Games each knockout of COMPETE_KO_MATRIX plays"),
   VALUE(TIMEOUT, double, 1.0, "Timeout for Minimax AI"),
+  VALUE(AI_TT_SIZE, size_t, 1048576, "How many transposition table entries does the Minimax AI get? (0 disables the table)"),
+  VALUE(AI_THREADS, size_t, 1, "How many threads does the Minimax AI search with?"),
+  VALUE(AI_NODE_LIMIT, size_t, 0, "If > 0, the Minimax AI searches this many nodes per move instead of using TIMEOUT"),
+  VALUE(AI_DEPTH_LIMIT, size_t, 0, "If > 0, the Minimax AI searches at most this many plies per move instead of using TIMEOUT"),
+  VALUE(AI_ENDGAME_EMPTIES, size_t, 0, "If > 0, the Minimax AI plays perfectly once this many squares or fewer are empty (the solve ignores TIMEOUT, so keep it small)"),
   VALUE(AGENT_KO, int, -1, "Which agentin the ensemble should we replace with nop operations. No knockout occurs if value is negative."),
   VALUE(INST_KO, size_t, 0, "What instructions should we replace with nop operations? \n0: None \n1: Multivote \n2: Confidence \n3: Communication"),
 
@@ -63,6 +79,10 @@ EMP_BUILD_CONFIG( EnsembleConfig,
   VALUE(SGP_PER_FUNC__FUNC_DEL_RATE, double, 0.05, "Per-function rate of function deletions."),
   VALUE(SGP_PER_FUNC__SLIP_RATE, double, 0.05, "TODO"),
 
+  GROUP(PERFORMANCE_GROUP, "Performance Settings"),
+  VALUE(EVAL_THREADS, size_t, 1, "How many worker threads evaluate the population? \n0: One per hardware thread"),
+  VALUE(EVAL_MEMO, bool, 0, "Reuse the score of a game when the same two genomes already played it this generation? \nGames are then seeded by the genomes playing rather than by agent, so runs differ from runs without it."),
+
   GROUP(DATA_GROUP, "Data Collection Settings"),
   VALUE(FITNESS_INTERVAL, size_t, 100, "Interval to record fitness summary stats."),
   VALUE(POP_SNAPSHOT_INTERVAL, size_t, 5000, "Interval to take a full snapshot of the population."),
@@ -4,12 +4,22 @@
 // @includes
 #include <iostream>
 #include <string>
+#include <map>
 #include <utility>
 #include <fstream>
 #include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
 #include <algorithm>
 #include <functional>
 #include <ctime>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <tuple>
 
 #include "base/Ptr.h"
 #include "base/vector.h"
@@ -19,18 +29,21 @@
 #include "Evolve/SystematicsAnalysis.h"
 #include "Evolve/World_output.h"
 #include "games/Othello8.h"
-#include "hardware/EventDrivenGP.h"
 #include "tools/BitVector.h"
 #include "tools/Random.h"
 #include "tools/random_utils.h"
 #include "tools/math.h"
 #include "tools/string_utils.h"
 #include "OthelloHW.h"
+#include "CompiledSGP.h"
+#include "CounterRandom.h"
+#include "GlickoRating.h"
 #include "ensemble-config.h"
 #include "../othelloAI/game.h"
 
 // SignalGP Specific Constants
 constexpr size_t SGP__TAG_WIDTH = 16;
+constexpr size_t SGP__MEM_SIZE = 16; ///< Memory kept in fixed registers; covers the default SGP_PROG_MAX_ARG_VAL.
 
 // Othello Specific Constants
 constexpr size_t OTHELLO_BOARD_WIDTH = 8;
@@ -51,6 +64,13 @@ constexpr size_t INST_KO_NONE = 0;
 constexpr size_t INST_KO_MULTI = 1;
 constexpr size_t INST_KO_CONF = 2;
 constexpr size_t INST_KO_COMM = 3;
+constexpr const char *INST_KO_NAMES[] = {"None", "Multivote", "Confidence", "Communication"}; // Indexed by INST_KO_*
+
+// Competitor types for competitions
+constexpr size_t COMPETITOR_ID__AI = 0;
+constexpr size_t COMPETITOR_ID__INDIVIDUAL = 1;
+constexpr size_t COMPETITOR_ID__ENSEMBLE = 2;
+constexpr const char *COMPETITOR_NAMES[] = {"ai", "individual", "ensemble"}; // Indexed by COMPETITOR_ID__*
 
 // Agent trait locations
 constexpr size_t TRAIT_ID__MOVE = 0;
@@ -60,6 +80,7 @@ constexpr size_t TRAIT_ID__LOC = 3;
 constexpr size_t TRAIT_ID__CONF = 4;
 constexpr size_t TRAIT_ID__CAST = 5;
 constexpr size_t TRAIT_ID__INVALID = 6;
+constexpr size_t TRAIT_ID__CTX = 7;
 
 // Population Initialization Method Options 
 constexpr size_t INIT_RANDOM = 0;
@@ -81,13 +102,13 @@ class EnsembleExp {
 // Aliases and Wrapper Structs
 public:
   // Othello type aliases
-  using othello_t = emp::Othello8;
+  using othello_t = othello_engine_t;
   using player_t = othello_t::Player;
   using facing_t = othello_t::Facing;
   using othello_idx_t = othello_t::Index;
 
   // SignalGP-specific type aliases:
-  using SGP__hardware_t = emp::EventDrivenGP_AW<SGP__TAG_WIDTH>;
+  using SGP__hardware_t = CompiledSGP<SGP__TAG_WIDTH, SGP__MEM_SIZE>;
   using SGP__program_t = SGP__hardware_t::Program;
   using SGP__state_t = SGP__hardware_t::State;
   using SGP__inst_t = SGP__hardware_t::inst_t;
@@ -96,11 +117,14 @@ public:
   using SGP__event_lib_t = SGP__hardware_t::event_lib_t;
   using SGP__memory_t = SGP__hardware_t::memory_t;
   using SGP__tag_t = SGP__hardware_t::affinity_t;
+  using SGP__exec_t = SGP__hardware_t::Executable;
 
   /// Agent structure to be used to wrap organisms
   struct SignalGPAgent
   {
     SGP__program_t program;
+    SGP__exec_t exec; ///< program, compiled by Compile; the evaluation hardware runs it in place.
+    uint64_t genome_hash = 0; ///< Hash of program, updated by Compile.
     size_t agent_id;
     size_t GetID() const { return agent_id; }
     void SetID(size_t id) { agent_id = id; }
@@ -112,24 +136,35 @@ public:
     }
 
     SignalGPAgent(const SignalGPAgent &&in)
-        : agent_id(in.agent_id), program(in.program)
+        : agent_id(in.agent_id), program(in.program), exec(in.exec), genome_hash(in.genome_hash)
     {
       ;
     }
 
     SignalGPAgent(const SignalGPAgent &in)
-        : agent_id(in.agent_id), program(in.program)
+        : agent_id(in.agent_id), program(in.program), exec(in.exec), genome_hash(in.genome_hash)
     {
       ;
     }
 
     SGP__program_t &GetGenome() { return program; }
+
+    /// Recompile program; must be called after the genome changes and before it is evaluated.
+    void Compile()
+    {
+      exec.Compile(program);
+      genome_hash = program.Hash();
+    }
+    const SGP__exec_t &GetExecutable() const { return exec; }
+    uint64_t GetGenomeHash() const { return genome_hash; }
   };
 
   /// Agent structure to be used to wrap ensembles
   struct GroupSignalGPAgent
   {
     emp::vector<SGP__program_t> programs;
+    emp::vector<SGP__exec_t> execs; ///< programs, compiled by Compile; the evaluation hardware runs them in place.
+    uint64_t genome_hash = 0;       ///< Hash of programs, updated by Compile.
     size_t agent_id;
     size_t GetID() const { return agent_id; }
     void SetID(size_t id) { agent_id = id; }
@@ -141,18 +176,34 @@ public:
     }
 
     GroupSignalGPAgent(const GroupSignalGPAgent &&in)
-        : agent_id(in.agent_id), programs(in.programs)
+        : agent_id(in.agent_id), programs(in.programs), execs(in.execs), genome_hash(in.genome_hash)
     {
       ;
     }
 
     GroupSignalGPAgent(const GroupSignalGPAgent &in)
-        : agent_id(in.agent_id), programs(in.programs)
+        : agent_id(in.agent_id), programs(in.programs), execs(in.execs), genome_hash(in.genome_hash)
     {
       ;
     }
 
     emp::vector<SGP__program_t> &GetGenome() { return programs; }
+
+    /// Recompile programs for the libraries their hardware runs: member 0 on coord_lib, the
+    /// others on lib (see EnsembleExp::CompileGroupAgent). Must be called after the genome
+    /// changes and before it is evaluated.
+    void Compile(const SGP__inst_lib_t &lib, const SGP__inst_lib_t &coord_lib)
+    {
+      execs.resize(programs.size());
+      genome_hash = programs.size();
+      for (size_t i = 0; i < programs.size(); ++i)
+      {
+        execs[i].Compile(programs[i], i ? lib : coord_lib);
+        genome_hash = programs[i].Hash(genome_hash);
+      }
+    }
+    const emp::vector<SGP__exec_t> &GetExecutables() const { return execs; }
+    uint64_t GetGenomeHash() const { return genome_hash; }
   };
 
   /// Struct to keep track of fitness for all heuristic functions
@@ -164,6 +215,82 @@ public:
     double median_score;
   };
 
+  /// Everything a single evaluation touches while it runs. Each evaluation thread owns
+  /// one worker, so agents can be played against each other concurrently.
+  struct EvalWorker
+  {
+    size_t id;                                            ///< Index of the evaluation thread that owns this worker.
+    CounterRandom game_random;                            ///< Random stream keyed to the game being played.
+    emp::Ptr<emp::Random> random;                         ///< Hardware random generator, reseeded from game_random every game.
+    emp::vector<emp::Ptr<OthelloHardware>> all_dreamware; ///< Dreamware for each ensemble member.
+    emp::Ptr<SGP__hardware_t> sgp_eval_hw;                ///< Hardware used to evaluate SignalGP programs.
+    emp::vector<emp::Ptr<SGP__hardware_t>> sgpg_eval_hw;  ///< Hardware used to evaluate Ensembles.
+    emp::Ptr<othello_t> game_hw;                          ///< Board of the game being played.
+    emp::Ptr<othello_t> test_hw;                          ///< Scratch board used by heuristic functions.
+    size_t eval_time;                                     ///< Current evaluation time point (within an agent's turn).
+    size_t vote_penalties;
+    double h_bonus;
+    int coordinator_id;
+    emp::array<size_t, OTHELLO_BOARD_NUM_CELLS + 1> agent_votes = {};
+    emp::array<size_t, OTHELLO_BOARD_NUM_CELLS + 1> h_choices = {};
+    emp::vector<size_t> live_members;                     ///< Ensemble members still taking their turn (see EvalMoveGroup).
+  };
+
+  /// What an instruction needs to know about the evaluation its hardware is part of.
+  /// Hardware finds its context through the TRAIT_ID__CTX trait (see GetEvalContext).
+  struct EvalContext
+  {
+    emp::Ptr<EvalWorker> worker;         ///< Board, vote tallies and coordinator of the evaluation.
+    emp::Ptr<OthelloHardware> dreamware; ///< Dreamware belonging to this hardware's agent.
+  };
+
+  /// A player in a competition: an evolved program, an evolved ensemble or the Minimax AI.
+  struct Competitor
+  {
+    size_t type;                           ///< One of COMPETITOR_ID__*.
+    std::string path;                      ///< File the program(s) came from.
+    emp::Ptr<SignalGPAgent> individual;    ///< Program played, for COMPETITOR_ID__INDIVIDUAL.
+    emp::Ptr<GroupSignalGPAgent> ensemble; ///< Ensemble played, for COMPETITOR_ID__ENSEMBLE.
+  };
+
+  /// Outcome of one competition game.
+  struct MatchResult
+  {
+    double score_1;    ///< Final disc count of the first competitor.
+    double score_2;    ///< Final disc count of the second competitor.
+    bool invalid;      ///< Did the game end on an invalid move (by curr_player)?
+    bool curr_player;  ///< Competitor to move when the game ended (0 is the first).
+    bool start_player; ///< Competitor that moved first.
+
+    /// Game points of the first competitor: 1 for a win, 0.5 for a tie and 0 for a loss.
+    /// Making an invalid move loses.
+    double GetPoints() const
+    {
+      if (invalid) return curr_player ? 1.0 : 0.0;
+      return (score_1 > score_2) ? 1.0 : ((score_1 == score_2) ? 0.5 : 0.0);
+    }
+  };
+
+  /// Totals of the first competitor over a set of games, counted as compete_ai.py does.
+  struct MatchTally
+  {
+    size_t wins = 0;
+    size_t losses = 0;
+    size_t ties = 0;
+    size_t invalid = 0;       ///< Games lost by making an invalid move (also counted in losses).
+    double total_score = 0.0; ///< Final disc counts, over the games without an invalid move.
+
+    void Add(const MatchResult &result)
+    {
+      const double points = result.GetPoints();
+      if (points == 1.0) ++wins;
+      else if (points == 0.0) ++losses;
+      else ++ties;
+      if (result.invalid && result.curr_player == 0) ++invalid;
+      if (!result.invalid) total_score += result.score_1;
+    }
+  };
+
   // Aliases for defined structs
   using phenotype_t = emp::vector<double>;
   using data_t = emp::mut_landscape_info<phenotype_t>;
@@ -187,7 +314,23 @@ protected:
   size_t COMPETE_TYPE;
   std::string COMPETE_FPATH_1;
   std::string COMPETE_FPATH_2;
+  size_t NUM_COMPETE_GAMES;
+  size_t COMPETE_OPENING_MOVES;
+  std::string COMPETE_MANIFEST;
+  std::string COMPETE_OUTPUT;
+  std::string COMPETE_RATING_POOL;
+  double COMPETE_RATING_RD;
+  size_t COMPETE_RATING_GAMES;
+  std::string COMPETE_RATING_OUTPUT;
+  std::string COMPETE_SERVER;
+  std::string COMPETE_KO_MATRIX;
+  size_t COMPETE_KO_GAMES;
   double TIMEOUT;
+  size_t AI_TT_SIZE;
+  size_t AI_THREADS;
+  size_t AI_NODE_LIMIT;
+  size_t AI_DEPTH_LIMIT;
+  size_t AI_ENDGAME_EMPTIES;
   int AGENT_KO;
   size_t INST_KO;
   // Ensemble Group parameters
@@ -228,37 +371,35 @@ protected:
   size_t FITNESS_INTERVAL;
   size_t POP_SNAPSHOT_INTERVAL;
   std::string DATA_DIRECTORY;
+  // Performance parameters
+  size_t EVAL_THREADS;
+  bool EVAL_MEMO;
 
   emp::Ptr<emp::Random> random;
 
   // Othello Player Types
-  emp::Othello8::Player dark = emp::Othello8::Player::DARK;
-  emp::Othello8::Player light = emp::Othello8::Player::LIGHT;
+  player_t dark = othello_t::DARK;
+  player_t light = othello_t::LIGHT;
 
   // Expirement hardware
-  emp::Ptr<OthelloHardware> othello_dreamware;          ///< Othello game board dreamware!
-  emp::vector<emp::Ptr<OthelloHardware>> all_dreamware; ///< Ensemble Othello game board dreamware!
-  emp::Ptr<SGP__hardware_t> sgp_eval_hw;                ///< Hardware used to evaluate SignalGP programs during evolution/analysis.
-  emp::vector <emp::Ptr<SGP__hardware_t>> sgpg_eval_hw; ///< Hardware used to evaluate Ensembles during evolution/analysis.
-  emp::Ptr<othello_t> game_hw;                          ///< Hardware used to evaluate games during fitness calculation
-  emp::Ptr<othello_t> test_hw;                          ///< Hardware used to run heuristic functions
+  emp::vector<emp::Ptr<EvalWorker>> eval_workers; ///< One set of evaluation hardware per evaluation thread.
+  emp::vector<EvalContext> eval_contexts;         ///< Context of every evaluation hardware, indexed by TRAIT_ID__CTX.
+  std::map<std::string, emp::Ptr<Competitor>> competitor_cache; ///< Competitors loaded so far, by type, agent knockout and path.
 
   // Expirement variables
   size_t update;                ///< Current update/generation.
-  size_t eval_time;             ///< Current evaluation time point (within an agent's turn).
   size_t OTHELLO_MAX_ROUND_CNT; ///< What are the maximum number of rounds in game?
   size_t best_agent_id;         ///< What is the id of the current best organism?
-  size_t vote_penalties;
-  double h_bonus;
-  int coordinator_id;
+  uint64_t eval_seed;           ///< Seed that keys every evaluation random stream.
+  int coordinator_id;           ///< Coordinator location each worker starts with.
 
   /// Fitness vectors
   emp::vector<Phenotype> agent_phen_cache;                                        ///< Cache for organims fitness.
-  emp::vector<std::function<othello_idx_t()>> heuristics;                         ///< Heuristic functions for fitness evaluation.
+  std::map<std::tuple<uint64_t, uint64_t, bool, int>, double> game_memo;         ///< Scores of this update's games by (genome, opponent genome, start player, coordinator), if EVAL_MEMO.
+  std::mutex game_memo_mutex;                                                     ///< Guards game_memo while workers evaluate.
+  emp::vector<std::function<othello_idx_t(EvalWorker &)>> heuristics;             ///< Heuristic functions for fitness evaluation.
   emp::vector<std::function<double(SignalGPAgent &)>> sgp_lexicase_fit_set;       ///< Fit set for SGP lexicase selection.
   emp::vector<std::function<double(GroupSignalGPAgent &)>> sgpg_lexicase_fit_set; ///< Fit set for SGP lexicase selection.
-  emp::array<size_t, OTHELLO_BOARD_NUM_CELLS + 1> agent_votes = {};
-  emp::array<size_t, OTHELLO_BOARD_NUM_CELLS + 1> h_choices = {};
 
   // SignalGP-specifics.
   emp::Ptr<SGP__world_t> sgp_world;         ///< World for evolving SignalGP agents.
@@ -266,6 +407,9 @@ protected:
   emp::Ptr<SGP__inst_lib_t> sgp_inst_lib;   ///< SignalGP instruction library.
   emp::Ptr<SGP__inst_lib_t> coord_inst_lib;   ///< SignalGP Coordinator instruction library.
   emp::Ptr<SGP__event_lib_t> sgp_event_lib; ///< SignalGP event library.
+  size_t inst_ko_applied = INST_KO_NONE;    ///< Instruction knockout (INST_KO_*) the libraries currently have.
+  std::map<std::string, SGP__inst_lib_t::fun_t> sgp_inst_ko_saved;   ///< Original definitions of sgp_inst_lib instructions knocked out so far.
+  std::map<std::string, SGP__inst_lib_t::fun_t> coord_inst_ko_saved; ///< Original definitions of coord_inst_lib instructions knocked out so far.
 
   // Systematics-specific signals for data tracking.
   emp::Signal<void(size_t)> do_pop_snapshot_sig;                      ///< Triggered if we should take a snapshot of the population (as defined by POP_SNAPSHOT_INTERVAL). Should call appropriate functions to take snapshot.
@@ -310,12 +454,19 @@ protected:
     return facing_t::N; //< Should never get here.
   }
 
+  /// Get the evaluation context of the given hardware.
+  /// Contexts are only added while building workers, so lookups are safe from any thread.
+  const EvalContext &GetEvalContext(const SGP__hardware_t &hw) const
+  {
+    return eval_contexts[(size_t)hw.GetTrait(TRAIT_ID__CTX)];
+  }
+
 // Experiment Method Declarations (with some definitions)
 public:
   /// Constructor for the expirement.
   /// param: config, the configured parameters for the expirement
   EnsembleExp(const EnsembleConfig &config) 
-    : update(0), eval_time(0), OTHELLO_MAX_ROUND_CNT(0), best_agent_id(0) {
+    : update(0), OTHELLO_MAX_ROUND_CNT(0), best_agent_id(0) {
 
     // Localize configs.
     RUN_MODE = config.RUN_MODE();
@@ -330,8 +481,24 @@ public:
     COMPETE_TYPE = config.COMPETE_TYPE();
     COMPETE_FPATH_1 = config.COMPETE_FPATH_1();
     COMPETE_FPATH_2 = config.COMPETE_FPATH_2();
+    NUM_COMPETE_GAMES = config.NUM_COMPETE_GAMES();
+    COMPETE_OPENING_MOVES = config.COMPETE_OPENING_MOVES();
+    COMPETE_MANIFEST = config.COMPETE_MANIFEST();
+    COMPETE_OUTPUT = config.COMPETE_OUTPUT();
+    COMPETE_RATING_POOL = config.COMPETE_RATING_POOL();
+    COMPETE_RATING_RD = config.COMPETE_RATING_RD();
+    COMPETE_RATING_GAMES = config.COMPETE_RATING_GAMES();
+    COMPETE_RATING_OUTPUT = config.COMPETE_RATING_OUTPUT();
+    COMPETE_SERVER = config.COMPETE_SERVER();
+    COMPETE_KO_MATRIX = config.COMPETE_KO_MATRIX();
+    COMPETE_KO_GAMES = config.COMPETE_KO_GAMES();
     AGENT_KO = config.AGENT_KO();
     TIMEOUT = config.TIMEOUT();
+    AI_TT_SIZE = config.AI_TT_SIZE();
+    AI_THREADS = config.AI_THREADS();
+    AI_NODE_LIMIT = config.AI_NODE_LIMIT();
+    AI_DEPTH_LIMIT = config.AI_DEPTH_LIMIT();
+    AI_ENDGAME_EMPTIES = config.AI_ENDGAME_EMPTIES();
     INST_KO = config.INST_KO();
     GROUP_SIZE = config.GROUP_SIZE();
     COMMUNICATION = config.COMMUNICATION();
@@ -363,6 +530,8 @@ public:
     FITNESS_INTERVAL = config.FITNESS_INTERVAL();
     POP_SNAPSHOT_INTERVAL = config.POP_SNAPSHOT_INTERVAL();
     DATA_DIRECTORY = config.DATA_DIRECTORY();
+    EVAL_THREADS = config.EVAL_THREADS();
+    EVAL_MEMO = config.EVAL_MEMO();
 
     // Make a random number generator.
     random = emp::NewPtr<emp::Random>(RANDOM_SEED);
@@ -381,17 +550,6 @@ public:
       agent_phen_cache[i].aggregate_score = 0;
     }
 
-    // Configure the dreamware!
-    for (size_t i = 0; i < GROUP_SIZE; ++i)
-    {
-      all_dreamware.push_back(emp::NewPtr<OthelloHardware>(1));
-    }
-    othello_dreamware = all_dreamware[0];
-
-    // Configure game evaluation hardware.
-    game_hw = emp::NewPtr<othello_t>();
-    test_hw = emp::NewPtr<othello_t>();
-
     // Make the worlds
     sgp_world = emp::NewPtr<SGP__world_t>(random, "SGP-Ensemble-World");
     sgpg_world = emp::NewPtr<SGPG__world_t>(random, "SGP-Group-Ensemble-World");
@@ -405,28 +563,13 @@ public:
     mkdir(DATA_DIRECTORY.c_str(), ACCESSPERMS);
     if (DATA_DIRECTORY.back() != '/') DATA_DIRECTORY += '/';
 
-    // Configure agent evaluation hardware
-    sgp_eval_hw = emp::NewPtr<SGP__hardware_t>(sgp_inst_lib, sgp_event_lib, random);
-    sgp_eval_hw->SetMinBindThresh(SGP_HW_MIN_BIND_THRESH);
-    sgp_eval_hw->SetMaxCores(SGP_HW_MAX_CORES);
-    sgp_eval_hw->SetMaxCallDepth(SGP_HW_MAX_CALL_DEPTH);
-
-    for (size_t i = 0; i < GROUP_SIZE; ++i)
+    // Configure agent evaluation hardware. Games draw their random numbers from streams keyed
+    // by (eval_seed, update, agent, game), so results do not depend on the number of workers.
+    eval_seed = (uint64_t)random->GetSeed();
+    if (EVAL_THREADS == 0) EVAL_THREADS = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t t = 0; t < EVAL_THREADS; ++t)
     {
-      emp::Ptr<SGP__hardware_t> temp;
-      if (COORDINATOR == COORDINATOR_REP_SPECIAL && i == 0)
-      {
-        temp = emp::NewPtr<SGP__hardware_t>(coord_inst_lib, sgp_event_lib, random);
-      }
-      else{
-        temp = emp::NewPtr<SGP__hardware_t>(sgp_inst_lib, sgp_event_lib, random);
-      }
-      
-      temp->SetMinBindThresh(SGP_HW_MIN_BIND_THRESH);
-      temp->SetMaxCores(SGP_HW_MAX_CORES);
-      temp->SetMaxCallDepth(SGP_HW_MAX_CALL_DEPTH);
-
-      sgpg_eval_hw.push_back(temp);
+      eval_workers.push_back(NewEvalWorker(t, sgp_inst_lib, coord_inst_lib));
     }
 
     ConfigSGP_InstLib(); // Configure instruction/Event libraries
@@ -460,7 +603,7 @@ public:
         sgp_inst_lib->AddInst("GetCoordinator",
                               [this](SGP__hardware_t &hw, const SGP__inst_t &inst) {
                                 SGP__state_t &state = hw.GetCurState();
-                                state.SetLocal(inst.args[0], coordinator_id);
+                                state.SetLocal(inst.args[0], GetEvalContext(hw).worker->coordinator_id);
                               },
                               1, "Returns the location of the current coordinator in the ensemble");
         coordinator_id = 0;
@@ -473,7 +616,7 @@ public:
         sgp_inst_lib->AddInst("GetCoordinator",
                               [this](SGP__hardware_t &hw, const SGP__inst_t &inst) {
                                 SGP__state_t &state = hw.GetCurState();
-                                state.SetLocal(inst.args[0], coordinator_id);
+                                state.SetLocal(inst.args[0], GetEvalContext(hw).worker->coordinator_id);
                               },
                               1, "Returns the location of the current coordinator in the ensemble");
         coordinator_id = 0;
@@ -519,32 +662,35 @@ public:
                               this->SGP__Inst_CastVote(hw, inst);
                               this->SGP_Inst_EndTurn(hw, inst); 
                             },
-                            0, "Ends the agents turn");
+                            0, "Ends the agents turn", emp::ScopeType::BASIC, 0, {"halt"});
 
       coord_inst_lib->AddInst("CastVote",
                             [this](SGP__hardware_t &hw, const SGP__inst_t &inst) {
                               this->SGP__Inst_CastVote(hw, inst);
                               this->SGP_Inst_EndTurn(hw, inst);
                             },
-                            0, "Ends the agents turn");
+                            0, "Ends the agents turn", emp::ScopeType::BASIC, 0, {"halt"});
     }
+    for (auto worker : eval_workers) worker->coordinator_id = coordinator_id;
     std::cout<<"Configured."<<std::endl;
   }
 
   /// Destructor for the expirement.
   ~EnsembleExp()
   {
-    random.Delete();
     sgp_world.Delete();
     sgpg_world.Delete();
     sgp_inst_lib.Delete();
     coord_inst_lib.Delete();
     sgp_event_lib.Delete();
-    sgp_eval_hw.Delete();
-	  game_hw.Delete();
-	  test_hw.Delete();
-    for (auto ptr : sgpg_eval_hw) {ptr.Delete();}
-    for (auto ptr : all_dreamware) {ptr.Delete();}
+    for (auto worker : eval_workers) DeleteEvalWorker(worker);
+    for (auto &cached : competitor_cache)
+    {
+      if (cached.second->individual) cached.second->individual.Delete();
+      if (cached.second->ensemble) cached.second->ensemble.Delete();
+      cached.second.Delete();
+    }
+    random.Delete();
   }
 
   /// Fitness function for cached fitness of individual agents
@@ -618,18 +764,47 @@ public:
   void Run();
   void RunStep();
   void RunSetup();
-  void ResetHardware();
-  void ResetHardwareGroup();
+  void ResetHardware(EvalWorker &worker);
+  void ResetHardwareGroup(EvalWorker &worker);
+
+  // Functions to manage evaluation workers
+  emp::Ptr<EvalWorker> NewEvalWorker(size_t id, emp::Ptr<SGP__inst_lib_t> inst_lib, emp::Ptr<SGP__inst_lib_t> coord_lib);
+  void DeleteEvalWorker(emp::Ptr<EvalWorker> worker);
+  void SeedEvalWorker(EvalWorker &worker, size_t agent_id, size_t game_id);
+  void CompileGroupAgent(GroupSignalGPAgent &agent);
+  double MemoEvalGame(EvalWorker &worker, uint64_t agent_hash, uint64_t opp_hash, bool start_player,
+                      const std::function<double()> &play);
+  void RunEvalWorkers(size_t job_cnt, const std::function<void(EvalWorker &, size_t)> &job);
 
   // Functions to manage othello games
-  double EvalGame(SignalGPAgent &agent, SignalGPAgent &opp, bool start_player);
-  double EvalGameGroup(GroupSignalGPAgent &agent, GroupSignalGPAgent &opp, bool start_player);
-  othello_idx_t EvalMove(SignalGPAgent &agent);
-  othello_idx_t EvalMoveGroup(GroupSignalGPAgent &agent);
+  double EvalGame(EvalWorker &worker, SignalGPAgent &agent, SignalGPAgent &opp, bool start_player);
+  double EvalGameGroup(EvalWorker &worker, GroupSignalGPAgent &agent, GroupSignalGPAgent &opp, bool start_player);
+  othello_idx_t EvalMove(EvalWorker &worker, SignalGPAgent &agent);
+  othello_idx_t EvalMoveGroup(EvalWorker &worker, GroupSignalGPAgent &agent);
   othello_idx_t EvalMoveAI(Game *game);
   
   // Functions to manage competition of evolved agents/ensembles
   void Compete();
+  void CompeteGames();
+  void CompeteBatch();
+  void CompeteRating();
+  void CompeteServer();
+  void CompeteKnockoutMatrix();
+  bool ServeCompeteRequest(const std::string &request, size_t &game_cnt, std::string &reply);
+  emp::vector<emp::Ptr<Competitor>> ReadCompetitors(const std::string &fpath, size_t count);
+  void OpenCompeteOutput(std::ofstream &output_fstream);
+  void WriteMatchResult(std::ostream &os, size_t match_id, const Competitor &player_1,
+                        const Competitor &player_2, const MatchResult &result);
+  MatchResult PlayCompeteMatch(EvalWorker &worker, size_t match_id, Competitor &player_1,
+                               Competitor &player_2, bool parallel);
+  void ConfigInstKnockout(size_t inst_ko);
+  emp::vector<std::pair<std::string, SGP__inst_lib_t::fun_t>> GetInstKnockouts(size_t inst_ko);
+  emp::Ptr<SGP__inst_lib_t> KnockoutInstLib(emp::Ptr<SGP__inst_lib_t> lib, size_t inst_ko);
+  bool ParseCompetitor(const emp::vector<std::string> &fields, size_t &pos, size_t &type, std::string &path);
+  emp::Ptr<Competitor> GetCompetitor(size_t type, const std::string &path, int agent_ko);
+  emp::vector<othello_idx_t> SampleOpening(EvalWorker &worker, size_t move_cnt);
+  MatchResult PlayMatch(EvalWorker &worker, Competitor &player_1, Competitor &player_2, bool start_player,
+                        const emp::vector<othello_idx_t> &opening, emp::Ptr<emp::Random> ai_random, bool report_ai, bool parallel);
   void AgentKnockout(GroupSignalGPAgent &ensemble, size_t ko_idx);
   Board::Move ConvertToMoveAI(Game *game, othello_idx_t move);
   emp::vector<SGP__program_t> LoadGroupCompete(std::string path);
@@ -638,6 +813,7 @@ public:
   // Functions run in each step of evolution
   void Evaluate();
   void EvaluateAll();
+  void RecordEvaluation(size_t pop_size);
   void Selection();
   void EvaluateGroup();
   void SelectionGroup();
@@ -666,8 +842,8 @@ public:
   void SGP__InitPopulation_FromAncestorFile();
   void SGPG__InitPopulation_Random();
   void SGPG__InitPopulation_FromAncestorFile();
-  void SGP__ResetHW(const SGP__memory_t &main_in_mem = SGP__memory_t());
-  void SGPG__ResetHW(const SGP__memory_t &main_in_mem = SGP__memory_t());
+  void SGP__ResetHW(EvalWorker &worker, const SGP__memory_t &main_in_mem = SGP__memory_t());
+  void SGPG__ResetHW(EvalWorker &worker, const SGP__memory_t &main_in_mem = SGP__memory_t());
 
   // -- Declarations of SignalGP Instructions defined in Ensemble_Instructions.h --
   // Event-based communication instructions
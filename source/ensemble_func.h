@@ -109,30 +109,31 @@ void EnsembleExp::ConfigSGPG() {
 
 /// Reset the SignalGP evaluation hardware, setting input memory of
 /// main thread to be equal to main_in_mem.
-void EnsembleExp::SGP__ResetHW(const SGP__memory_t &main_in_mem)
+void EnsembleExp::SGP__ResetHW(EvalWorker &worker, const SGP__memory_t &main_in_mem)
 {
-  sgp_eval_hw->ResetHardware();
-  sgp_eval_hw->SetTrait(TRAIT_ID__MOVE, -1);
-  sgp_eval_hw->SetTrait(TRAIT_ID__DONE, 0);
-  sgp_eval_hw->SetTrait(TRAIT_ID__CONF, 1);
-  sgp_eval_hw->SpawnCore(0, main_in_mem, true);
+  worker.sgp_eval_hw->ResetHardware();
+  worker.sgp_eval_hw->SetTrait(TRAIT_ID__MOVE, -1);
+  worker.sgp_eval_hw->SetTrait(TRAIT_ID__DONE, 0);
+  worker.sgp_eval_hw->SetTrait(TRAIT_ID__CONF, 1);
+  worker.sgp_eval_hw->SpawnCore(0, main_in_mem, true);
 }
 
 /// Reset the SignalGP evaluation hardware, setting input memory of
 /// main thread to be equal to main_in_mem.
-void EnsembleExp::SGPG__ResetHW(const SGP__memory_t &main_in_mem)
+void EnsembleExp::SGPG__ResetHW(EvalWorker &worker, const SGP__memory_t &main_in_mem)
 {
   for (size_t i = 0; i < GROUP_SIZE; ++i)
   {
-    sgpg_eval_hw[i]->ResetHardware();
-    sgpg_eval_hw[i]->SetTrait(TRAIT_ID__MOVE, -1);
-    sgpg_eval_hw[i]->SetTrait(TRAIT_ID__DONE, 0);
-    sgpg_eval_hw[i]->SetTrait(TRAIT_ID__GID, 0);
-    sgpg_eval_hw[i]->SetTrait(TRAIT_ID__LOC, i);
-    sgpg_eval_hw[i]->SetTrait(TRAIT_ID__CONF, 1);
-    sgpg_eval_hw[i]->SetTrait(TRAIT_ID__CAST, 0);
-    sgpg_eval_hw[i]->SetTrait(TRAIT_ID__INVALID, 0);
-    sgpg_eval_hw[i]->SpawnCore(0, main_in_mem, true);
+    emp::Ptr<SGP__hardware_t> hw = worker.sgpg_eval_hw[i];
+    hw->ResetHardware();
+    hw->SetTrait(TRAIT_ID__MOVE, -1);
+    hw->SetTrait(TRAIT_ID__DONE, 0);
+    hw->SetTrait(TRAIT_ID__GID, 0);
+    hw->SetTrait(TRAIT_ID__LOC, i);
+    hw->SetTrait(TRAIT_ID__CONF, 1);
+    hw->SetTrait(TRAIT_ID__CAST, 0);
+    hw->SetTrait(TRAIT_ID__INVALID, 0);
+    hw->SpawnCore(0, main_in_mem, true);
   }
 }
 
@@ -762,18 +763,18 @@ void EnsembleExp::ConfigHeuristics()
 {
   std::cout<<"Configuring Heuristic Functions!"<<std::endl;
 
-  std::function<othello_idx_t()> random_player = [this]() {
-    emp::vector<othello_idx_t> options = game_hw->GetMoveOptions();
-    return options[random->GetUInt(0, options.size())];
+  std::function<othello_idx_t(EvalWorker &)> random_player = [this](EvalWorker &worker) {
+    emp::vector<othello_idx_t> options = worker.game_hw->GetMoveOptions();
+    return options[worker.game_random.GetUInt(0, options.size())];
   };
 
-  std::function<othello_idx_t()> greedy_player = [this]() {
-	  emp::vector<othello_idx_t> options = game_hw->GetMoveOptions();
+  std::function<othello_idx_t(EvalWorker &)> greedy_player = [this](EvalWorker &worker) {
+	  emp::vector<othello_idx_t> options = worker.game_hw->GetMoveOptions();
 	  // returns move that flips the most pieces
 	  size_t max_flips = 0;
 	  othello_idx_t max_move;
 	  for (auto move : options){
-		  size_t flips = game_hw->GetFlipCount(game_hw->GetCurPlayer(), move);
+		  size_t flips = worker.game_hw->GetFlipCount(worker.game_hw->GetCurPlayer(), move);
 		  if (flips > max_flips){
 			  max_flips = flips;
 			  max_move = move;
@@ -783,36 +784,36 @@ void EnsembleExp::ConfigHeuristics()
   };
 
   // not really tested...
-  std::function<othello_idx_t()> corner_player = [this]() {
-	  emp::vector<othello_idx_t> options = game_hw->GetMoveOptions();
+  std::function<othello_idx_t(EvalWorker &)> corner_player = [this](EvalWorker &worker) {
+	  emp::vector<othello_idx_t> options = worker.game_hw->GetMoveOptions();
 	  othello_idx_t id0((size_t)0);
-	  if (game_hw->IsValidMove(game_hw->GetCurPlayer(), id0)){
+	  if (worker.game_hw->IsValidMove(worker.game_hw->GetCurPlayer(), id0)){
 		  return id0;
 	  }
 	  othello_idx_t id7((size_t)7);
-	  if (game_hw->IsValidMove(game_hw->GetCurPlayer(), id7)){
+	  if (worker.game_hw->IsValidMove(worker.game_hw->GetCurPlayer(), id7)){
 		  return id7;
 	  }
 	  othello_idx_t id56((size_t)56);
-	  if (game_hw->IsValidMove(game_hw->GetCurPlayer(), id56)){
+	  if (worker.game_hw->IsValidMove(worker.game_hw->GetCurPlayer(), id56)){
 		  return id56;
 	  }
 	  othello_idx_t id63((size_t)63);
-	  if (game_hw->IsValidMove(game_hw->GetCurPlayer(), id63)){
+	  if (worker.game_hw->IsValidMove(worker.game_hw->GetCurPlayer(), id63)){
 		  return id63;
 	  }
-	  return options[random->GetUInt(0, options.size())];
+	  return options[worker.game_random.GetUInt(0, options.size())];
   };
 
-  std::function<othello_idx_t()> frontier_player = [this]() {
-	  emp::vector<othello_idx_t> options = game_hw->GetMoveOptions();
+  std::function<othello_idx_t(EvalWorker &)> frontier_player = [this](EvalWorker &worker) {
+	  emp::vector<othello_idx_t> options = worker.game_hw->GetMoveOptions();
 	  size_t min_frontier = 64;
 	  othello_idx_t min_move;
 	  // find move to minimize own frontier
 	  for (auto move : options){
-		  test_hw->SetBoard(game_hw->GetBoard());
-		  test_hw->DoMove(game_hw->GetCurPlayer(), move);
-		  size_t frontier = test_hw->CountFrontierPos(game_hw->GetCurPlayer());                                                                                          
+		  worker.test_hw->SetBoard(worker.game_hw->GetBoard());
+		  worker.test_hw->DoMove(worker.game_hw->GetCurPlayer(), move);
+		  size_t frontier = worker.test_hw->CountFrontierPos(worker.game_hw->GetCurPlayer());                                                                                          
 		  if (frontier < min_frontier){
 			  min_frontier = frontier;
 			  min_move = move;
@@ -821,15 +822,15 @@ void EnsembleExp::ConfigHeuristics()
 	  return min_move;
   };
   
-  std::function<othello_idx_t()> defense_player = [this]() {
-	  emp::vector<othello_idx_t> options = game_hw->GetMoveOptions();
+  std::function<othello_idx_t(EvalWorker &)> defense_player = [this](EvalWorker &worker) {
+	  emp::vector<othello_idx_t> options = worker.game_hw->GetMoveOptions();
 	  size_t min_moves = 64;
 	  othello_idx_t min_move;
 	  // minimize moves opponent can make                                                                                                                                                                                                                                                                                                                               pponent can make
 	  for (auto move : options){
-		  test_hw->SetBoard(game_hw->GetBoard());
-		  test_hw->DoMove(game_hw->GetCurPlayer(), move);
-		  emp::vector<othello_idx_t> op_options = test_hw->GetMoveOptions(game_hw->GetOpponent(game_hw->GetCurPlayer()));
+		  worker.test_hw->SetBoard(worker.game_hw->GetBoard());
+		  worker.test_hw->DoMove(worker.game_hw->GetCurPlayer(), move);
+		  emp::vector<othello_idx_t> op_options = worker.test_hw->GetMoveOptions(worker.game_hw->GetOpponent(worker.game_hw->GetCurPlayer()));
 		  if (op_options.size() < min_moves){
 			  min_moves = op_options.size();
 			  min_move = move;
@@ -883,93 +884,228 @@ void EnsembleExp::Run()
 }
 
 /// Resets the state of the organism being evaluated.
-void EnsembleExp::ResetHardware()
+void EnsembleExp::ResetHardware(EvalWorker &worker)
 {
-  SGP__ResetHW();
-  othello_dreamware->Reset(*game_hw);
-  othello_dreamware->SetActiveDream(0);
+  SGP__ResetHW(worker);
+  worker.all_dreamware[0]->Reset(*worker.game_hw);
+  worker.all_dreamware[0]->SetActiveDream(0);
 }
 
 /// Resets the state of the organism being evaluated.
-void EnsembleExp::ResetHardwareGroup()
+void EnsembleExp::ResetHardwareGroup(EvalWorker &worker)
 {
-  SGPG__ResetHW();
-  for (auto dreamware : all_dreamware)
+  SGPG__ResetHW(worker);
+  for (auto dreamware : worker.all_dreamware)
   {
-    dreamware->Reset(*game_hw);
+    dreamware->Reset(*worker.game_hw);
     dreamware->SetActiveDream(0);
   }
 }
 
+/// Build a full set of evaluation hardware for evaluation thread id, running agents on
+/// inst_lib and special coordinators on coord_lib. Seed it with SeedEvalWorker before each game.
+emp::Ptr<EnsembleExp::EvalWorker> EnsembleExp::NewEvalWorker(size_t id, emp::Ptr<SGP__inst_lib_t> inst_lib,
+                                                             emp::Ptr<SGP__inst_lib_t> coord_lib)
+{
+  emp::Ptr<EvalWorker> worker = emp::NewPtr<EvalWorker>();
+  worker->id = id;
+  worker->random = emp::NewPtr<emp::Random>(1);
+  worker->eval_time = 0;
+  worker->vote_penalties = 0;
+  worker->h_bonus = 0;
+  worker->coordinator_id = -1;
+
+  // Configure the dreamware!
+  for (size_t i = 0; i < GROUP_SIZE; ++i)
+  {
+    worker->all_dreamware.push_back(emp::NewPtr<OthelloHardware>(1));
+  }
+
+  // Configure game evaluation hardware.
+  worker->game_hw = emp::NewPtr<othello_t>();
+  worker->test_hw = emp::NewPtr<othello_t>();
+
+  worker->sgp_eval_hw = emp::NewPtr<SGP__hardware_t>(inst_lib, sgp_event_lib, worker->random);
+  worker->sgp_eval_hw->SetMinBindThresh(SGP_HW_MIN_BIND_THRESH);
+  worker->sgp_eval_hw->SetMaxCores(SGP_HW_MAX_CORES);
+  worker->sgp_eval_hw->SetMaxCallDepth(SGP_HW_MAX_CALL_DEPTH);
+  worker->sgp_eval_hw->SetTrait(TRAIT_ID__CTX, eval_contexts.size());
+  eval_contexts.push_back({worker, worker->all_dreamware[0]});
+
+  for (size_t i = 0; i < GROUP_SIZE; ++i)
+  {
+    emp::Ptr<SGP__hardware_t> temp;
+    if (COORDINATOR == COORDINATOR_REP_SPECIAL && i == 0)
+    {
+      temp = emp::NewPtr<SGP__hardware_t>(coord_lib, sgp_event_lib, worker->random);
+    }
+    else
+    {
+      temp = emp::NewPtr<SGP__hardware_t>(inst_lib, sgp_event_lib, worker->random);
+    }
+
+    temp->SetMinBindThresh(SGP_HW_MIN_BIND_THRESH);
+    temp->SetMaxCores(SGP_HW_MAX_CORES);
+    temp->SetMaxCallDepth(SGP_HW_MAX_CALL_DEPTH);
+    temp->SetTrait(TRAIT_ID__CTX, eval_contexts.size());
+    eval_contexts.push_back({worker, worker->all_dreamware[i]});
+
+    worker->sgpg_eval_hw.push_back(temp);
+  }
+  return worker;
+}
+
+/// Free a worker built by NewEvalWorker. Its entries in eval_contexts are left for the caller to drop.
+void EnsembleExp::DeleteEvalWorker(emp::Ptr<EvalWorker> worker)
+{
+  worker->sgp_eval_hw.Delete();
+  worker->game_hw.Delete();
+  worker->test_hw.Delete();
+  for (auto ptr : worker->sgpg_eval_hw) {ptr.Delete();}
+  for (auto ptr : worker->all_dreamware) {ptr.Delete();}
+  worker->random.Delete();
+  worker.Delete();
+}
+
+/// Key the worker's random streams to one game of the current update, so the game plays
+/// out the same no matter which worker runs it or in what order.
+void EnsembleExp::SeedEvalWorker(EvalWorker &worker, size_t agent_id, size_t game_id)
+{
+  worker.game_random.Reset(eval_seed, update, agent_id, game_id);
+  worker.random->ResetSeed(worker.game_random.GetSeed());
+}
+
+/// Score of play(), the game between the genomes hashed to agent_hash and opp_hash. With
+/// EVAL_MEMO the game is seeded by those genomes, so it plays out the same for every agent
+/// carrying them, and is only played the first time they meet this update.
+double EnsembleExp::MemoEvalGame(EvalWorker &worker, uint64_t agent_hash, uint64_t opp_hash, bool start_player,
+                                 const std::function<double()> &play)
+{
+  if (!EVAL_MEMO) return play();
+
+  const auto key = std::make_tuple(agent_hash, opp_hash, start_player, worker.coordinator_id);
+  {
+    std::lock_guard<std::mutex> lock(game_memo_mutex);
+    auto it = game_memo.find(key);
+    if (it != game_memo.end()) return it->second;
+  }
+
+  worker.game_random.Reset(eval_seed, update, agent_hash, opp_hash, start_player, (uint64_t)worker.coordinator_id);
+  worker.random->ResetSeed(worker.game_random.GetSeed());
+  const double score = play();
+
+  // Another worker may have played the same game meanwhile; it scored the same.
+  std::lock_guard<std::mutex> lock(game_memo_mutex);
+  game_memo.emplace(key, score);
+  return score;
+}
+
+/// Compile agent for the hardware NewEvalWorker runs it on: with special coordinators, member 0
+/// runs on coord_inst_lib, whose instruction ids differ from sgp_inst_lib's.
+void EnsembleExp::CompileGroupAgent(GroupSignalGPAgent &agent)
+{
+  agent.Compile(*sgp_inst_lib, (COORDINATOR == COORDINATOR_REP_SPECIAL) ? *coord_inst_lib : *sgp_inst_lib);
+}
+
+/// Run job(worker, i) for every i in [0, job_cnt), handing jobs out to the evaluation
+/// workers as they finish their previous one. Jobs must only write state owned by
+/// their worker or indexed by i.
+void EnsembleExp::RunEvalWorkers(size_t job_cnt, const std::function<void(EvalWorker &, size_t)> &job)
+{
+  const size_t thread_cnt = std::min(eval_workers.size(), job_cnt);
+  if (thread_cnt <= 1)
+  {
+    for (size_t i = 0; i < job_cnt; ++i) job(*eval_workers[0], i);
+    return;
+  }
+
+  std::atomic<size_t> next_job(0);
+  emp::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_cnt; ++t)
+  {
+    threads.emplace_back([this, t, job_cnt, &next_job, &job]() {
+      for (size_t i = next_job++; i < job_cnt; i = next_job++) job(*eval_workers[t], i);
+    });
+  }
+  for (auto &thread : threads) thread.join();
+}
+
 /// Evaluate a single move for the currently selected organism.
 /// param: agent, the current organism to evaluate
 /// returns: the given agent's move
-EnsembleExp::othello_idx_t EnsembleExp::EvalMove(SignalGPAgent &agent)
+EnsembleExp::othello_idx_t EnsembleExp::EvalMove(EvalWorker &worker, SignalGPAgent &agent)
 {
-  sgp_eval_hw->SetProgram(agent.GetGenome());
-  ResetHardware();
-  // Run agent until time is up or until agent indicates it is done evaluating.
-  for (eval_time = 0; eval_time < EVAL_TIME && !(bool)sgp_eval_hw->GetTrait(TRAIT_ID__DONE); ++eval_time)
+  emp_assert(agent.GetExecutable().GetSize() == agent.program.GetSize(), "Compile the agent before it plays.");
+  worker.sgp_eval_hw->SetProgram(agent.GetExecutable());
+  ResetHardware(worker);
+  // Run agent until time is up, until agent indicates it is done evaluating, or until it has nothing left to run.
+  for (worker.eval_time = 0; worker.eval_time < EVAL_TIME && !(bool)worker.sgp_eval_hw->GetTrait(TRAIT_ID__DONE) && !worker.sgp_eval_hw->IsIdle(); ++worker.eval_time)
   { 
-    sgp_eval_hw->SingleProcess();
+    worker.sgp_eval_hw->SingleProcess();
   }
 
-  return GetOthelloIndex((size_t)sgp_eval_hw->GetTrait(TRAIT_ID__MOVE));
+  return GetOthelloIndex((size_t)worker.sgp_eval_hw->GetTrait(TRAIT_ID__MOVE));
 }
 
 /// Evaluate a single move for the currently selected organism.
 /// param: agent, the current organism to evaluate
 /// returns: the given agent's move
-EnsembleExp::othello_idx_t EnsembleExp::EvalMoveGroup(GroupSignalGPAgent &agent)
+EnsembleExp::othello_idx_t EnsembleExp::EvalMoveGroup(EvalWorker &worker, GroupSignalGPAgent &agent)
 {
-  agent_votes = {};
-  h_choices = {};
+  worker.agent_votes = {};
+  worker.h_choices = {};
   emp::vector<size_t> move_choices;
   size_t most_votes = 0;
 
-  emp::vector<SGP__program_t> & genomes = agent.GetGenome();
+  const emp::vector<SGP__exec_t> & execs = agent.GetExecutables();
+  emp_assert(execs.size() == agent.programs.size(), "Compile the agent before it plays.");
 
-  for (size_t i = 0; i < genomes.size(); ++i)
+  for (size_t i = 0; i < execs.size(); ++i)
   {
-    sgpg_eval_hw[i]->SetProgram(genomes[i]);
+    worker.sgpg_eval_hw[i]->SetProgram(execs[i]);
   }
 
-  ResetHardwareGroup();
-  
-  // Run agent until time is up or until agent indicates it is done evaluating.
-  for (eval_time = 0; eval_time < EVAL_TIME; ++eval_time)
+  ResetHardwareGroup(worker);
+
+  // Run agent until time is up, or until every member has ended its turn or gone idle. Members
+  // that ended their turn leave the live list for good; idle members (no cores, no events) are
+  // skipped, since only a message from a member that is still running can wake them up.
+  emp::vector<size_t> &live_members = worker.live_members;
+  live_members.resize(worker.sgpg_eval_hw.size());
+  for (size_t i = 0; i < live_members.size(); ++i) live_members[i] = i;
+  for (worker.eval_time = 0; worker.eval_time < EVAL_TIME && live_members.size(); ++worker.eval_time)
   {
-    for (size_t i = 0; i < sgpg_eval_hw.size(); ++i)
+    bool ran = false;
+    size_t live_cnt = 0;
+    for (size_t i : live_members)
     {
-      //std::cout<<"Eval: "<<eval_time<<std::endl;
-      if ((bool)sgpg_eval_hw[i]->GetTrait(TRAIT_ID__DONE)){
-        //std::cout<<"Skip: "<<i<<std::endl;
-        continue;
-      } 
-      
-      othello_dreamware = all_dreamware[i];
-      sgpg_eval_hw[i]->SingleProcess();
-      // std::cout<<"Org "<<i<<std::endl;
-      // sgpg_eval_hw[i]->PrintState();
-      // std::cout<<"-----------------------"<<std::endl;
+      SGP__hardware_t &hw = *worker.sgpg_eval_hw[i];
+      if (!hw.IsIdle())
+      {
+        hw.SingleProcess();
+        ran = true;
+      }
+      if (!(bool)hw.GetTrait(TRAIT_ID__DONE)) live_members[live_cnt++] = i;
     }
+    live_members.resize(live_cnt);
+    if (!ran) break;
   }
 
-  for (size_t i = 0; i < agent_votes.size(); ++i)
+  for (size_t i = 0; i < worker.agent_votes.size(); ++i)
   {
-    if (agent_votes[i] == 0) continue;
-    if (!game_hw->IsValidMove(game_hw->GetCurPlayer(), GetOthelloIndex(i)))
+    if (worker.agent_votes[i] == 0) continue;
+    if (!worker.game_hw->IsValidMove(worker.game_hw->GetCurPlayer(), GetOthelloIndex(i)))
     {
       //std::cout<<"Bad vote: "<<i<<" : "<<agent_votes[i]<<std::endl;
       continue;
     } 
-    if (agent_votes[i] > most_votes)
+    if (worker.agent_votes[i] > most_votes)
     {
       move_choices.clear();
       move_choices.push_back(i);
-      most_votes = agent_votes[i];
+      most_votes = worker.agent_votes[i];
     }
-    else if (agent_votes[i] == most_votes)
+    else if (worker.agent_votes[i] == most_votes)
     {
       move_choices.push_back(i);
     }
@@ -977,29 +1113,29 @@ EnsembleExp::othello_idx_t EnsembleExp::EvalMoveGroup(GroupSignalGPAgent &agent)
 
   size_t move_count = move_choices.size();
   //std::cout<<"move count: "<<move_count<<std::endl;
-  return move_count ? GetOthelloIndex(move_choices[random->GetUInt(0, move_count)]) : GetOthelloIndex(OTHELLO_BOARD_NUM_CELLS);
+  return move_count ? GetOthelloIndex(move_choices[worker.game_random.GetUInt(0, move_count)]) : GetOthelloIndex(OTHELLO_BOARD_NUM_CELLS);
 }
 
 /// Evaluates an organism on a game of Othello.
 /// param: agent, the organism to be evaluated
 /// param: heuristic_func, the handwritten AI the organism will compete against
 /// returns: the score of the organism.
-double EnsembleExp::EvalGame(SignalGPAgent &agent, SignalGPAgent &opp, bool start_player)
+double EnsembleExp::EvalGame(EvalWorker &worker, SignalGPAgent &agent, SignalGPAgent &opp, bool start_player)
 {
   // Initialize othello game
-  game_hw->Reset();
+  worker.game_hw->Reset();
   double score = 0;
   bool curr_player = start_player; //random->GetInt(0,2); //Choose start player, 0 is individual, 1 is opponent
 
   // Main game loop
   for(size_t round_num = 0; round_num < OTHELLO_MAX_ROUND_CNT; ++round_num)
   {
-    othello_dreamware->SetPlayerID((curr_player == start_player) ? othello_t::DARK : othello_t::LIGHT);
-    othello_idx_t move = (curr_player == 0) ? EvalMove(agent) : EvalMove(opp);
+    worker.all_dreamware[0]->SetPlayerID((curr_player == start_player) ? othello_t::DARK : othello_t::LIGHT);
+    othello_idx_t move = (curr_player == 0) ? EvalMove(worker, agent) : EvalMove(worker, opp);
     score = round_num;
 
     //If a invalid move is given, fitness becomes rounds completed w/o error
-    if (!game_hw->IsValidMove(game_hw->GetCurPlayer(), move))
+    if (!worker.game_hw->IsValidMove(worker.game_hw->GetCurPlayer(), move))
     {
       if (curr_player == 0)
       {
@@ -1007,22 +1143,22 @@ double EnsembleExp::EvalGame(SignalGPAgent &agent, SignalGPAgent &opp, bool star
       }
       else
       {
-        emp::vector<othello_idx_t> options = game_hw->GetMoveOptions();
-        move = options[random->GetUInt(0, options.size())];
+        emp::vector<othello_idx_t> options = worker.game_hw->GetMoveOptions();
+        move = options[worker.game_random.GetUInt(0, options.size())];
       }
     }
 
-    bool go_again = game_hw->DoNextMove(move);
-    if (game_hw->IsOver()) break;
+    bool go_again = worker.game_hw->DoNextMove(move);
+    if (worker.game_hw->IsOver()) break;
     if (!go_again) curr_player = !curr_player; //Change current player if you don't get another turn
   }
 
   // Setup for score calculation
   int rounds_left = OTHELLO_MAX_ROUND_CNT - (score + 1);
-  double hero_score = game_hw->GetScore((start_player == 0) ? dark : light);
-  double opp_score = game_hw->GetScore((start_player == 1) ? dark : light);
+  double hero_score = worker.game_hw->GetScore((start_player == 0) ? dark : light);
+  double opp_score = worker.game_hw->GetScore((start_player == 1) ? dark : light);
   emp_assert(rounds_left >= 0);
-  emp_assert(game_hw->IsOver());
+  emp_assert(worker.game_hw->IsOver());
 
   // Bonus for completing game, increased by performance in game. Max possible fitness is 235 per heuristic.
   score = 2 * OTHELLO_MAX_ROUND_CNT + hero_score;
@@ -1035,37 +1171,37 @@ double EnsembleExp::EvalGame(SignalGPAgent &agent, SignalGPAgent &opp, bool star
 /// param: agent, the organism to be evaluated
 /// param: heuristic_func, the handwritten AI the organism will compete against
 /// returns: the score of the organism.
-double EnsembleExp::EvalGameGroup(GroupSignalGPAgent &agent, GroupSignalGPAgent &opp, bool start_player)
+double EnsembleExp::EvalGameGroup(EvalWorker &worker, GroupSignalGPAgent &agent, GroupSignalGPAgent &opp, bool start_player)
 {
   // Initialize othello game
-  game_hw->Reset();
+  worker.game_hw->Reset();
   double score = 0;
-  vote_penalties = 0;
-  h_bonus = 0;
+  worker.vote_penalties = 0;
+  worker.h_bonus = 0;
   bool curr_player = start_player; //random->GetInt(0, 2); //Choose start player, 0 is individual, 1 is heuristic
 
   // Main game loop
   for (size_t round_num = 0; round_num < OTHELLO_MAX_ROUND_CNT; ++round_num)
   {
-    for (auto dreamware : all_dreamware)
+    for (auto dreamware : worker.all_dreamware)
     {
       dreamware->SetPlayerID((curr_player == start_player) ? othello_t::DARK : othello_t::LIGHT);
     }
-    othello_idx_t move = (curr_player == 0) ? EvalMoveGroup(agent) : EvalMoveGroup(opp);
+    othello_idx_t move = (curr_player == 0) ? EvalMoveGroup(worker, agent) : EvalMoveGroup(worker, opp);
     score = round_num;
 
     if (curr_player == 0)
     {
-      for (auto hw : sgpg_eval_hw)
+      for (auto hw : worker.sgpg_eval_hw)
       {
         size_t num_votes = hw->GetTrait(TRAIT_ID__CAST);
         size_t num_invalid = hw->GetTrait(TRAIT_ID__INVALID);
 
         if (num_votes < 1)
-          vote_penalties += PENALTY;
+          worker.vote_penalties += PENALTY;
         else
         {
-          vote_penalties += PENALTY * num_invalid;
+          worker.vote_penalties += PENALTY * num_invalid;
         }
       }
 
@@ -1073,31 +1209,31 @@ double EnsembleExp::EvalGameGroup(GroupSignalGPAgent &agent, GroupSignalGPAgent
       {
         emp_assert(MULTIVOTE == 0);
         double bonus = double(GROUP_SIZE - 1) * -1;
-        for (size_t i = 0; i < h_choices.size(); ++i)
+        for (size_t i = 0; i < worker.h_choices.size(); ++i)
         {
-          bonus += h_choices[i];
+          bonus += worker.h_choices[i];
         }
         emp_assert(bonus <= 0);
-        bonus += h_choices[move.pos];
-        h_bonus += bonus;
-        emp_assert(h_bonus <= 120);
-        emp_assert(h_bonus >= -120);
+        bonus += worker.h_choices[move.pos];
+        worker.h_bonus += bonus;
+        emp_assert(worker.h_bonus <= 120);
+        emp_assert(worker.h_bonus >= -120);
       }
     }
 
     //If a invalid move is given, fitness becomes rounds completed w/o error
-    if (!game_hw->IsValidMove(game_hw->GetCurPlayer(), move))
+    if (!worker.game_hw->IsValidMove(worker.game_hw->GetCurPlayer(), move))
     {
-      if (curr_player == 0) return score - vote_penalties;
+      if (curr_player == 0) return score - worker.vote_penalties;
       else
       {
-        emp::vector<othello_idx_t> options = game_hw->GetMoveOptions();
-        move = options[random->GetUInt(0, options.size())];
+        emp::vector<othello_idx_t> options = worker.game_hw->GetMoveOptions();
+        move = options[worker.game_random.GetUInt(0, options.size())];
       }
     }
 
-    bool go_again = game_hw->DoNextMove(move);
-    if (game_hw->IsOver())
+    bool go_again = worker.game_hw->DoNextMove(move);
+    if (worker.game_hw->IsOver())
       break;
     if (!go_again)
       curr_player = !curr_player; //Change current player if you don't get another turn
@@ -1105,13 +1241,13 @@ double EnsembleExp::EvalGameGroup(GroupSignalGPAgent &agent, GroupSignalGPAgent
 
   // Setup for score calculation
   int rounds_left = OTHELLO_MAX_ROUND_CNT - (score + 1);
-  double hero_score = game_hw->GetScore((start_player == 0) ? dark : light);
-  double opp_score = game_hw->GetScore((start_player == 1) ? dark : light);
+  double hero_score = worker.game_hw->GetScore((start_player == 0) ? dark : light);
+  double opp_score = worker.game_hw->GetScore((start_player == 1) ? dark : light);
   emp_assert(rounds_left >= 0);
-  emp_assert(game_hw->IsOver());
+  emp_assert(worker.game_hw->IsOver());
 
   // Bonus for completing game, increased by performance in game. Max possible fitness is 235 per heuristic.
-  score = 2 * OTHELLO_MAX_ROUND_CNT + hero_score - vote_penalties + h_bonus;
+  score = 2 * OTHELLO_MAX_ROUND_CNT + hero_score - worker.vote_penalties + worker.h_bonus;
   if (hero_score > opp_score)
   {
     score += 2 * rounds_left;
@@ -1123,14 +1259,17 @@ double EnsembleExp::EvalGameGroup(GroupSignalGPAgent &agent, GroupSignalGPAgent
 /// Calculate fitness for all organisms in the population.
 void EnsembleExp::Evaluate()
 {
-  double best_score = -32767;
-  best_agent_id = 0;
-
+  // Compile every genome up front, so the workers only ever read them.
   for (size_t id = 0; id < sgp_world->GetSize(); ++id)
   {
+    sgp_world->GetOrg(id).SetID(id);
+    sgp_world->GetOrg(id).Compile();
+  }
+  game_memo.clear();
+
+  RunEvalWorkers(sgp_world->GetSize(), [this](EvalWorker &worker, size_t id) {
     // Evaluate agent given by id.
     SignalGPAgent &our_hero = sgp_world->GetOrg(id);
-    our_hero.SetID(id);
 
     // Initialize fitness tracking object
     Phenotype &phen = agent_phen_cache[id];
@@ -1140,14 +1279,15 @@ void EnsembleExp::Evaluate()
 
     for (size_t i = 0; i < NUM_GAMES; ++i)
     {
+      SeedEvalWorker(worker, id, i);
       // Find a random opponent from the population
-      size_t opp_id = random->GetInt(0, sgp_world->GetSize());
+      size_t opp_id = worker.game_random.GetInt(0, sgp_world->GetSize());
       SignalGPAgent &our_opp = sgp_world->GetOrg(opp_id);
-      our_opp.SetID(opp_id);
 
-      bool start_player = random->GetInt(0, 2);
+      bool start_player = worker.game_random.GetInt(0, 2);
 
-      phen.heuristic_scores[i] = EvalGame(our_hero, our_opp, start_player);
+      phen.heuristic_scores[i] = MemoEvalGame(worker, our_hero.GetGenomeHash(), our_opp.GetGenomeHash(), start_player,
+                                              [&]() { return EvalGame(worker, our_hero, our_opp, start_player); });
       phen.aggregate_score += phen.heuristic_scores[i]; // Sum of scores is fitness of organism
       if (phen.heuristic_scores[i] < OTHELLO_MAX_ROUND_CNT) {phen.illegal_move_total++;} //TODO
     }
@@ -1162,31 +1302,25 @@ void EnsembleExp::Evaluate()
     {
       phen.median_score = (temp[temp.size() / 2 - 1] + temp[temp.size() / 2]) / 2;
     }
-    //std::cout<<"AGG SCORE: "<<phen.aggregate_score<<std::endl<<std::endl;
-    // Write current fitness information to file
-    record_fit_sig.Trigger(id, phen.median_score);
-    record_phen_sig.Trigger(id, phen.heuristic_scores);
+  });
 
-    if (phen.median_score > best_score)
-    {
-      best_score = phen.median_score;
-      best_agent_id = id;
-    }
-  }
-  std::cout << "Update: " << update << " Max score: " << best_score << std::endl;
+  RecordEvaluation(sgp_world->GetSize());
 }
 
 /// Calculate fitness for all organisms in the population.
 void EnsembleExp::EvaluateAll()
 {
-  double best_score = -32767;
-  best_agent_id = 0;
-
+  // Compile every genome up front, so the workers only ever read them.
   for (size_t id = 0; id < sgpg_world->GetSize(); ++id)
   {
+    sgpg_world->GetOrg(id).SetID(id);
+    CompileGroupAgent(sgpg_world->GetOrg(id));
+  }
+  game_memo.clear();
+
+  RunEvalWorkers(sgpg_world->GetSize(), [this](EvalWorker &worker, size_t id) {
     // Evaluate agent given by id.
     GroupSignalGPAgent &our_hero = sgpg_world->GetOrg(id);
-    our_hero.SetID(id);
 
     // Initialize fitness tracking object
     Phenotype &phen = agent_phen_cache[id];
@@ -1196,15 +1330,16 @@ void EnsembleExp::EvaluateAll()
     for (size_t i = 0; i < NUM_GAMES; ++i)
     {
       emp_assert(NUM_GAMES == GROUP_SIZE);
-      coordinator_id = i;
+      worker.coordinator_id = i;
+      SeedEvalWorker(worker, id, i);
       // Find a random opponent from the population
-      size_t opp_id = random->GetInt(0, sgpg_world->GetSize());
+      size_t opp_id = worker.game_random.GetInt(0, sgpg_world->GetSize());
       GroupSignalGPAgent &our_opp = sgpg_world->GetOrg(opp_id);
-      our_opp.SetID(opp_id);
 
-      bool start_player = random->GetInt(0, 2);
+      bool start_player = worker.game_random.GetInt(0, 2);
 
-      phen.heuristic_scores[i] = EvalGameGroup(our_hero, our_opp, start_player);
+      phen.heuristic_scores[i] = MemoEvalGame(worker, our_hero.GetGenomeHash(), our_opp.GetGenomeHash(), start_player,
+                                              [&]() { return EvalGameGroup(worker, our_hero, our_opp, start_player); });
       phen.aggregate_score += phen.heuristic_scores[i]; // Sum of scores is fitness of organism
     }
 
@@ -1218,6 +1353,21 @@ void EnsembleExp::EvaluateAll()
     {
       phen.median_score = (temp[temp.size() / 2 - 1] + temp[temp.size() / 2]) / 2;
     }
+  });
+
+  RecordEvaluation(sgpg_world->GetSize());
+}
+
+/// Record the phenotypes workers left in agent_phen_cache and find the best agent.
+/// Runs on the main thread, in population order, once every agent has been evaluated.
+void EnsembleExp::RecordEvaluation(size_t pop_size)
+{
+  double best_score = -32767;
+  best_agent_id = 0;
+
+  for (size_t id = 0; id < pop_size; ++id)
+  {
+    Phenotype &phen = agent_phen_cache[id];
     //std::cout<<"AGG SCORE: "<<phen.aggregate_score<<std::endl<<std::endl;
     // Write current fitness information to file
     record_fit_sig.Trigger(id, phen.median_score);
@@ -1264,14 +1414,17 @@ void EnsembleExp::Selection()
 /// Calculate fitness for all organisms in the population.
 void EnsembleExp::EvaluateGroup()
 {
-  double best_score = -32767;
-  best_agent_id = 0;
-
+  // Compile every genome up front, so the workers only ever read them.
   for (size_t id = 0; id < sgpg_world->GetSize(); ++id)
   {
+    sgpg_world->GetOrg(id).SetID(id);
+    CompileGroupAgent(sgpg_world->GetOrg(id));
+  }
+  game_memo.clear();
+
+  RunEvalWorkers(sgpg_world->GetSize(), [this](EvalWorker &worker, size_t id) {
     // Evaluate agent given by id.
     GroupSignalGPAgent &our_hero = sgpg_world->GetOrg(id);
-    our_hero.SetID(id);
 
     // Initialize fitness tracking object
     Phenotype &phen = agent_phen_cache[id];
@@ -1280,14 +1433,15 @@ void EnsembleExp::EvaluateGroup()
 
     for (size_t i = 0; i < NUM_GAMES; ++i)
     {
+      SeedEvalWorker(worker, id, i);
       // Find a random opponent from the population
-      size_t opp_id = random->GetInt(0, sgpg_world->GetSize());
+      size_t opp_id = worker.game_random.GetInt(0, sgpg_world->GetSize());
       GroupSignalGPAgent &our_opp = sgpg_world->GetOrg(opp_id);
-      our_opp.SetID(opp_id);
 
-      bool start_player = random->GetInt(0, 2);
+      bool start_player = worker.game_random.GetInt(0, 2);
 
-      phen.heuristic_scores[i] = EvalGameGroup(our_hero, our_opp, start_player);
+      phen.heuristic_scores[i] = MemoEvalGame(worker, our_hero.GetGenomeHash(), our_opp.GetGenomeHash(), start_player,
+                                              [&]() { return EvalGameGroup(worker, our_hero, our_opp, start_player); });
       phen.aggregate_score += phen.heuristic_scores[i]; // Sum of scores is fitness of organism
       if (phen.heuristic_scores[i] < OTHELLO_MAX_ROUND_CNT) //TODO
       {
@@ -1305,18 +1459,9 @@ void EnsembleExp::EvaluateGroup()
     {
       phen.median_score = (temp[temp.size() / 2 - 1] + temp[temp.size() / 2]) / 2;
     }
-    //std::cout<<"AGG SCORE: "<<phen.aggregate_score<<std::endl<<std::endl;
-    // Write current fitness information to file
-    record_fit_sig.Trigger(id, phen.median_score);
-    record_phen_sig.Trigger(id, phen.heuristic_scores);
+  });
 
-    if (phen.median_score > best_score)
-    {
-      best_score = phen.median_score;
-      best_agent_id = id;
-    }
-  }
-  std::cout << "Update: " << update << " Max score: " << best_score << std::endl;
+  RecordEvaluation(sgpg_world->GetSize());
 }
 
 /// Select organisms for next generation using given selection method.
@@ -1431,8 +1576,277 @@ void EnsembleExp::AgentKnockout(GroupSignalGPAgent &ensemble, size_t ko_idx)
   ensemble.programs[ko_idx] = knockout;
 }
 
+/// Replacement definitions of the instructions knockout inst_ko (INST_KO_*) removes, by name.
+/// A replacement for a "halt" instruction must still end the turn: compiled programs leave out
+/// the code after those.
+emp::vector<std::pair<std::string, EnsembleExp::SGP__inst_lib_t::fun_t>> EnsembleExp::GetInstKnockouts(size_t inst_ko)
+{
+  emp::vector<std::pair<std::string, SGP__inst_lib_t::fun_t>> knockouts;
+  switch (inst_ko)
+  {
+    case INST_KO_NONE:
+      break;
+
+    case INST_KO_MULTI:
+      knockouts.emplace_back("CastVote", [this](SGP__hardware_t &hw, const SGP__inst_t &inst) {
+                                           this->SGP__Inst_CastVote(hw, inst);
+                                           this->SGP_Inst_EndTurn(hw, inst);
+                                         });
+      break;
+
+    case INST_KO_CONF:
+      knockouts.emplace_back("SetConfidence", SGP__hardware_t::Inst_Nop);
+      knockouts.emplace_back("GetMoveConfidence", SGP__hardware_t::Inst_Nop);
+      break;
+
+    case INST_KO_COMM:
+      knockouts.emplace_back("SendMsgFacing", SGP__hardware_t::Inst_Nop);
+      knockouts.emplace_back("BroadcastMsg", SGP__hardware_t::Inst_Nop);
+      break;
+
+    default:
+      std::cout << "Invalid Instruction Knockout Value (" << inst_ko << "). Exiting..." << std::endl;
+      exit(-1);
+  }
+  return knockouts;
+}
+
+/// Apply instruction knockout inst_ko (INST_KO_*) to the instruction libraries. Instructions an
+/// earlier call knocked out get their definitions back first, so the knockout can change between games.
+void EnsembleExp::ConfigInstKnockout(size_t inst_ko)
+{
+  for (auto &saved : sgp_inst_ko_saved) sgp_inst_lib->UpdateInst(saved.first, saved.second);
+  for (auto &saved : coord_inst_ko_saved) coord_inst_lib->UpdateInst(saved.first, saved.second);
+
+  // Knock each instruction out of whichever libraries have it.
+  auto knockout_lib = [](SGP__inst_lib_t &lib, std::map<std::string, SGP__inst_lib_t::fun_t> &saved,
+                         const std::string &name, const SGP__inst_lib_t::fun_t &fun) {
+    for (size_t id = 0; id < lib.GetSize(); ++id)
+    {
+      if (lib.GetName(id) != name) continue;
+      if (!saved.count(name)) saved[name] = lib.GetFunction(id);
+      lib.UpdateInst(name, fun);
+    }
+  };
+  for (auto &knockout : GetInstKnockouts(inst_ko))
+  {
+    knockout_lib(*sgp_inst_lib, sgp_inst_ko_saved, knockout.first, knockout.second);
+    knockout_lib(*coord_inst_lib, coord_inst_ko_saved, knockout.first, knockout.second);
+  }
+  inst_ko_applied = inst_ko;
+  // The hardware runs default instructions itself, so it has to see which ones were replaced.
+  for (auto worker : eval_workers)
+  {
+    worker->sgp_eval_hw->RefreshInstLib();
+    for (auto hw : worker->sgpg_eval_hw) hw->RefreshInstLib();
+  }
+
+  if (inst_ko == INST_KO_NONE) std::cout << "No Instruction Knockout" << std::endl;
+  else std::cout << "Instruction Knockout: " << INST_KO_NAMES[inst_ko] << std::endl;
+}
+
+/// Instruction library lib with knockout inst_ko applied, leaving lib untouched. A library the
+/// knockout doesn't change is shared rather than copied, so the result is lib itself.
+emp::Ptr<EnsembleExp::SGP__inst_lib_t> EnsembleExp::KnockoutInstLib(emp::Ptr<SGP__inst_lib_t> lib, size_t inst_ko)
+{
+  emp::Ptr<SGP__inst_lib_t> ko_lib = lib;
+  for (auto &knockout : GetInstKnockouts(inst_ko))
+  {
+    for (size_t id = 0; id < lib->GetSize(); ++id)
+    {
+      if (lib->GetName(id) != knockout.first) continue;
+      if (ko_lib == lib) ko_lib = emp::NewPtr<SGP__inst_lib_t>(*lib);
+      ko_lib->UpdateInst(knockout.first, knockout.second);
+    }
+  }
+  return ko_lib;
+}
+
+/// Read the competitor starting at fields[pos] ("ai", "individual <path>" or "ensemble <path>")
+/// and move pos past it. Returns false if fields[pos] doesn't start a competitor.
+bool EnsembleExp::ParseCompetitor(const emp::vector<std::string> &fields, size_t &pos, size_t &type, std::string &path)
+{
+  const size_t type_cnt = sizeof(COMPETITOR_NAMES) / sizeof(COMPETITOR_NAMES[0]);
+  if (pos >= fields.size()) return false;
+  type = std::find(COMPETITOR_NAMES, COMPETITOR_NAMES + type_cnt, fields[pos]) - COMPETITOR_NAMES;
+  if (type == type_cnt) return false;
+
+  const bool has_path = (type != COMPETITOR_ID__AI);
+  if (has_path && pos + 1 == fields.size()) return false;
+  path = has_path ? fields[pos + 1] : "";
+  pos += has_path ? 2 : 1;
+  return true;
+}
+
+/// Load a competitor of the given type (COMPETITOR_ID__*) from path, or return it if it was
+/// already loaded. Ensembles have agent agent_ko knocked out (none if negative).
+emp::Ptr<EnsembleExp::Competitor> EnsembleExp::GetCompetitor(size_t type, const std::string &path, int agent_ko)
+{
+  if (type != COMPETITOR_ID__ENSEMBLE) agent_ko = -1;
+  const std::string key = std::to_string(type) + ":" + std::to_string(agent_ko) + ":" + path;
+  auto cached = competitor_cache.find(key);
+  if (cached != competitor_cache.end()) return cached->second;
+
+  emp::Ptr<Competitor> competitor = emp::NewPtr<Competitor>();
+  competitor->type = type;
+  competitor->path = path;
+  switch (type)
+  {
+    case COMPETITOR_ID__AI:
+      break;
+
+    case COMPETITOR_ID__INDIVIDUAL:
+      competitor->individual = emp::NewPtr<SignalGPAgent>(LoadIndividualCompete(path));
+      competitor->individual->SetID(0);
+      competitor->individual->Compile();
+      break;
+
+    case COMPETITOR_ID__ENSEMBLE:
+      competitor->ensemble = emp::NewPtr<GroupSignalGPAgent>(LoadGroupCompete(path));
+      competitor->ensemble->SetID(0);
+      if (agent_ko > -1)
+      {
+        emp_assert(agent_ko < (int)competitor->ensemble->programs.size());
+        AgentKnockout(*competitor->ensemble, agent_ko);
+      }
+      CompileGroupAgent(*competitor->ensemble);
+      break;
+
+    default:
+      std::cout << "Unrecognized competitor type (" << type << "). Exiting..." << std::endl;
+      exit(-1);
+  }
+  competitor_cache[key] = competitor;
+  return competitor;
+}
+
+/// Play one game between two competitors on the worker's hardware.
+/// param: start_player, which competitor plays dark, i.e. moves first (0 is player_1)
+/// param: opening, moves played before the competitors take over (see SampleOpening)
+/// param: ai_random, random generator the Minimax AI breaks ties with
+/// param: report_ai, print the depth and node count of every Minimax AI move?
+/// param: parallel, are other games being played at the same time? (The Minimax AI then
+///        times itself in wall time, as its usual CPU time covers every thread.)
+/// returns: final scores, and who was to move if the game ended on an invalid move
+EnsembleExp::MatchResult EnsembleExp::PlayMatch(EvalWorker &worker, Competitor &player_1, Competitor &player_2, bool start_player,
+                                                const emp::vector<othello_idx_t> &opening, emp::Ptr<emp::Random> ai_random,
+                                                bool report_ai, bool parallel)
+{
+  emp::array<emp::Ptr<Competitor>, 2> players = {{&player_1, &player_2}};
+  emp::array<emp::Ptr<Game>, 2> ai_games = {{nullptr, nullptr}};
+  for (size_t p = 0; p < players.size(); ++p)
+  {
+    if (players[p]->type != COMPETITOR_ID__AI) continue;
+    ai_games[p] = emp::NewPtr<Game>(ai_random, AI_TT_SIZE);
+    ai_games[p]->timeLimit = TIMEOUT;
+    ai_games[p]->threads = (int)AI_THREADS;
+    ai_games[p]->wallClock = parallel;
+    ai_games[p]->nodeLimit = (long)AI_NODE_LIMIT;
+    ai_games[p]->maxDepth = (int)AI_DEPTH_LIMIT;
+    ai_games[p]->endgameEmpties = (int)AI_ENDGAME_EMPTIES;
+    ai_games[p]->board = Board();
+  }
+
+  // Initialize othello game
+  worker.game_hw->Reset();
+  MatchResult result;
+  result.invalid = false;
+  result.start_player = start_player;
+
+  // Play a move on every board; returns whether the same color goes again.
+  auto do_move = [&worker, &ai_games, this](othello_idx_t move) {
+    bool go_again = worker.game_hw->DoNextMove(move);
+    for (auto ai_game : ai_games)
+    {
+      if (!ai_game) continue;
+      ai_game->board.ApplyMove(ConvertToMoveAI(ai_game.Raw(), move));
+      if (!go_again) ai_game->board.NextPlayer(false);
+    }
+    return go_again;
+  };
+  for (othello_idx_t move : opening) do_move(move);
+  bool curr_player = (worker.game_hw->GetCurPlayer() == dark) ? start_player : !start_player;
+
+  // Main game loop
+  for (size_t round_num = 0; round_num < OTHELLO_MAX_ROUND_CNT && !worker.game_hw->IsOver(); ++round_num)
+  {
+    for (auto dreamware : worker.all_dreamware)
+    {
+      dreamware->SetPlayerID((curr_player == start_player) ? othello_t::DARK : othello_t::LIGHT);
+    }
+
+    Competitor &mover = *players[curr_player];
+    othello_idx_t move;
+    switch (mover.type)
+    {
+      case COMPETITOR_ID__AI:
+        move = EvalMoveAI(ai_games[curr_player].Raw());
+        if (report_ai)
+        {
+          std::cout << "AI move: " << move.pos << " depth: " << ai_games[curr_player]->searchDepth
+                    << " nodes: " << ai_games[curr_player]->nodes << std::endl;
+        }
+        break;
+      case COMPETITOR_ID__INDIVIDUAL:
+        move = EvalMove(worker, *mover.individual);
+        break;
+      default:
+        move = EvalMoveGroup(worker, *mover.ensemble);
+        break;
+    }
+
+    //If a invalid move is given, the game ends and the mover loses
+    if (!worker.game_hw->IsValidMove(worker.game_hw->GetCurPlayer(), move))
+    {
+      result.invalid = true;
+      break;
+    }
+
+    bool go_again = do_move(move);
+    if (worker.game_hw->IsOver())
+      break;
+    if (!go_again)
+      curr_player = !curr_player; //Change current player if you don't get another turn
+  }
+  result.score_1 = worker.game_hw->GetScore((start_player == 0) ? dark : light);
+  result.score_2 = worker.game_hw->GetScore((start_player == 1) ? dark : light);
+  result.curr_player = curr_player;
+
+  for (auto ai_game : ai_games)
+  {
+    if (ai_game) ai_game.Delete();
+  }
+  return result;
+}
+
 void EnsembleExp::Compete()
 {
+  if (COMPETE_SERVER != "")
+  {
+    CompeteServer();
+    return;
+  }
+  if (COMPETE_KO_MATRIX != "")
+  {
+    CompeteKnockoutMatrix();
+    return;
+  }
+  if (COMPETE_RATING_POOL != "")
+  {
+    CompeteRating();
+    return;
+  }
+  if (COMPETE_MANIFEST != "")
+  {
+    CompeteBatch();
+    return;
+  }
+  if (NUM_COMPETE_GAMES > 1)
+  {
+    CompeteGames();
+    return;
+  }
+
   do_pop_init_sig.Trigger();
 
   GroupSignalGPAgent &our_hero = sgpg_world->GetOrg(0);
@@ -1444,108 +1858,502 @@ void EnsembleExp::Compete()
     emp_assert(AGENT_KO < our_hero.programs.size());
     AgentKnockout(our_hero, AGENT_KO);
   }
+  CompileGroupAgent(our_hero);
+
+  ConfigInstKnockout(INST_KO);
+
+  // Compete runs a single game, so the first evaluation worker owns it.
+  EvalWorker &worker = *eval_workers[0];
+  SeedEvalWorker(worker, 0, 0);
+
+  Competitor hero;
+  hero.type = COMPETITOR_ID__ENSEMBLE;
+  hero.path = ANCESTOR_FPATH;
+  hero.ensemble = &our_hero;
+  bool start_player = random->GetInt(0, 2); //Choose start player 
 
-  switch (INST_KO)
+  if (COORDINATOR == COORDINATOR_REP_ALL)
   {
-    case INST_KO_NONE:
-      std::cout<<"No Instruction Knockout"<<std::endl;
-      break;
-    
-    case INST_KO_MULTI:
-      std::cout << "Instruction Knockout: Multivote" << std::endl;
-      sgp_inst_lib->UpdateInst("CastVote",
-                            [this](SGP__hardware_t &hw, const SGP__inst_t &inst) {
-                              this->SGP__Inst_CastVote(hw, inst);
-                              this->SGP_Inst_EndTurn(hw, inst);
-                              std::cout << "MULTIVOTE KNOCKOUT" << std::endl;
-                            });
-
-      coord_inst_lib->UpdateInst("CastVote",
-                              [this](SGP__hardware_t &hw, const SGP__inst_t &inst) {
-                                this->SGP__Inst_CastVote(hw, inst);
-                                this->SGP_Inst_EndTurn(hw, inst);
-                                std::cout<<"MULTIVOTE KNOCKOUT"<<std::endl;
-                              });
-      break;
+    worker.coordinator_id = random->GetInt(0, GROUP_SIZE);
+  }
 
-    case INST_KO_CONF:
-      std::cout << "Instruction Knockout: Confidence" << std::endl;
-      sgp_inst_lib->UpdateInst("SetConfidence", SGP__hardware_t::Inst_Nop );
-      sgp_inst_lib->UpdateInst("GetMoveConfidence", SGP__hardware_t::Inst_Nop);
-      coord_inst_lib->UpdateInst("SetConfidence", SGP__hardware_t::Inst_Nop);
-      coord_inst_lib->UpdateInst("GetMoveConfidence", SGP__hardware_t::Inst_Nop);
-      break;
+  MatchResult result = PlayMatch(worker, hero, *GetCompetitor(COMPETITOR_ID__AI, "", -1), start_player, {}, random, true, false);
 
-    case INST_KO_COMM:
-      std::cout << "Instruction Knockout: Communication" << std::endl;
-      sgp_inst_lib->UpdateInst("SendMsgFacing", SGP__hardware_t::Inst_Nop);
-      sgp_inst_lib->UpdateInst("BroadcastMsg", SGP__hardware_t::Inst_Nop);
-      coord_inst_lib->UpdateInst("SendMsgFacing", SGP__hardware_t::Inst_Nop);
-      coord_inst_lib->UpdateInst("BroadcastMsg", SGP__hardware_t::Inst_Nop);
-      break;
+  std::cout<<result.score_1<<" "<<result.score_2<<" "<<result.invalid<< " "<<result.curr_player<<" "<<result.start_player<<std::endl;
+}
 
-    default:
-      std::cout << "Invalid Instruction Knockout Value (" << INST_KO << "). Exiting..." << std::endl;
+/// Play NUM_COMPETE_GAMES games between the ANCESTOR_FPATH program(s) and the Minimax AI, in pairs
+/// that start from the same opening (COMPETE_OPENING_MOVES random moves) with colors swapped.
+/// Games are spread over the evaluation workers and written to COMPETE_OUTPUT; the totals are printed.
+void EnsembleExp::CompeteGames()
+{
+  ConfigInstKnockout(INST_KO);
+
+  const size_t type = (REPRESENTATION == REPRESENTATION_ID__SIGNALGP) ? COMPETITOR_ID__INDIVIDUAL : COMPETITOR_ID__ENSEMBLE;
+  Competitor &hero = *GetCompetitor(type, ANCESTOR_FPATH, AGENT_KO);
+  Competitor &ai = *GetCompetitor(COMPETITOR_ID__AI, "", -1);
+
+  std::ofstream output_fstream;
+  OpenCompeteOutput(output_fstream);
+
+  emp::vector<MatchResult> results(NUM_COMPETE_GAMES);
+  const bool parallel = std::min(eval_workers.size(), results.size()) > 1;
+  std::mutex output_mutex;
+  RunEvalWorkers(results.size(), [this, &hero, &ai, &results, &output_fstream, &output_mutex, parallel](EvalWorker &worker, size_t game) {
+    // Both games of a pair draw the same random numbers, so only the colors differ.
+    SeedEvalWorker(worker, game / 2, 0);
+    emp::vector<othello_idx_t> opening = SampleOpening(worker, COMPETE_OPENING_MOVES);
+    if (COORDINATOR == COORDINATOR_REP_ALL)
+    {
+      worker.coordinator_id = worker.game_random.GetInt(0, GROUP_SIZE);
+    }
+    results[game] = PlayMatch(worker, hero, ai, game % 2, opening, worker.random, false, parallel);
+
+    std::lock_guard<std::mutex> lock(output_mutex);
+    WriteMatchResult(output_fstream, game, hero, ai, results[game]);
+  });
+
+  MatchTally tally;
+  for (const MatchResult &result : results) tally.Add(result);
+  std::cout << "Wins: " << tally.wins << " Losses: " << tally.losses << " Ties: " << tally.ties << " Invalid: " << tally.invalid
+            << " Average Score: " << tally.total_score / results.size() << " Games Played: " << results.size() << std::endl;
+  std::cout << "Games written to " << COMPETE_OUTPUT << std::endl;
+}
+
+/// Random legal moves from the starting position (fewer if the game would end), drawn from
+/// worker.game_random. Leaves the opening on worker.game_hw.
+emp::vector<EnsembleExp::othello_idx_t> EnsembleExp::SampleOpening(EvalWorker &worker, size_t move_cnt)
+{
+  emp::vector<othello_idx_t> opening;
+  worker.game_hw->Reset();
+  while (opening.size() < move_cnt)
+  {
+    emp::vector<othello_idx_t> options = worker.game_hw->GetMoveOptions();
+    othello_idx_t move = options[worker.game_random.GetUInt(options.size())];
+    othello_t next = *worker.game_hw;
+    next.DoNextMove(move);
+    if (next.IsOver()) break;
+    *worker.game_hw = next;
+    opening.push_back(move);
+  }
+  return opening;
+}
+
+/// Read the competitors listed in fpath, count per line, in file order. A competitor is "ai",
+/// "individual <path>" or "ensemble <path>"; blank lines and anything after a '#' are ignored.
+emp::vector<emp::Ptr<EnsembleExp::Competitor>> EnsembleExp::ReadCompetitors(const std::string &fpath, size_t count)
+{
+  std::ifstream competitor_fstream(fpath);
+  if (!competitor_fstream.is_open())
+  {
+    std::cout << "Failed to open competitor file (" << fpath << "). Exiting..." << std::endl;
+    exit(-1);
+  }
+
+  emp::vector<emp::Ptr<Competitor>> competitors;
+  std::string line;
+  for (size_t line_num = 1; std::getline(competitor_fstream, line); ++line_num)
+  {
+    std::stringstream ss(line.substr(0, line.find('#')));
+    emp::vector<std::string> fields;
+    std::string field;
+    while (ss >> field) fields.push_back(field);
+    if (fields.empty()) continue;
+
+    size_t line_cnt = 0;
+    size_t pos = 0;
+    while (pos < fields.size())
+    {
+      size_t type;
+      std::string path;
+      if (!ParseCompetitor(fields, pos, type, path))
+      {
+        std::cout << "Bad competitor in " << fpath << " line " << line_num << ": " << line << std::endl;
+        exit(-1);
+      }
+      competitors.push_back(GetCompetitor(type, path, AGENT_KO));
+      ++line_cnt;
+    }
+    if (line_cnt != count)
+    {
+      std::cout << "Expected " << count << " competitor(s) in " << fpath << " line " << line_num << ": " << line << std::endl;
       exit(-1);
+    }
   }
+  return competitors;
+}
 
-  // Initialize othello game
-  game_hw->Reset();
-  Game ai_game(random);
-  ai_game.timeLimit = TIMEOUT;
-  ai_game.board = Board();
-  // Board ai_board;
-  size_t p1_wins = 0;
-  size_t p2_wins = 0;
-  bool invalid = false;
-  bool curr_player = random->GetInt(0, 2); //Choose start player 
-  bool start_player = curr_player;
+/// Open COMPETE_OUTPUT and write the header of the per-game CSV.
+void EnsembleExp::OpenCompeteOutput(std::ofstream &output_fstream)
+{
+  output_fstream.open(COMPETE_OUTPUT);
+  if (!output_fstream.is_open())
+  {
+    std::cout << "Failed to open compete output file (" << COMPETE_OUTPUT << "). Exiting..." << std::endl;
+    exit(-1);
+  }
+  output_fstream << "match,type_1,path_1,type_2,path_2,score_1,score_2,invalid,curr_player,start_player" << std::endl;
+}
+
+/// Write one per-game CSV row (see OpenCompeteOutput).
+void EnsembleExp::WriteMatchResult(std::ostream &os, size_t match_id, const Competitor &player_1,
+                                   const Competitor &player_2, const MatchResult &result)
+{
+  os << match_id << "," << COMPETITOR_NAMES[player_1.type] << "," << player_1.path << ","
+     << COMPETITOR_NAMES[player_2.type] << "," << player_2.path << ","
+     << result.score_1 << "," << result.score_2 << "," << result.invalid << ","
+     << result.curr_player << "," << result.start_player << std::endl;
+}
 
+/// Play match match_id of a batch. Each match draws its randomness from its own stream,
+/// keyed by match_id, so results don't depend on which worker plays it.
+EnsembleExp::MatchResult EnsembleExp::PlayCompeteMatch(EvalWorker &worker, size_t match_id, Competitor &player_1,
+                                                       Competitor &player_2, bool parallel)
+{
+  SeedEvalWorker(worker, match_id, 0);
+  bool start_player = worker.game_random.GetInt(0, 2);
   if (COORDINATOR == COORDINATOR_REP_ALL)
   {
-    coordinator_id = random->GetInt(0, GROUP_SIZE);
+    worker.coordinator_id = worker.game_random.GetInt(0, GROUP_SIZE);
+  }
+  return PlayMatch(worker, player_1, player_2, start_player, {}, worker.random, false, parallel);
+}
+
+/// Play every pairing listed in COMPETE_MANIFEST (two competitors per line) in this process,
+/// loading each program file once, and write one CSV row per game to COMPETE_OUTPUT as soon
+/// as it finishes. Matches are spread over the evaluation workers (EVAL_THREADS), so rows
+/// arrive out of order.
+void EnsembleExp::CompeteBatch()
+{
+  ConfigInstKnockout(INST_KO);
+
+  emp::vector<emp::Ptr<Competitor>> matches = ReadCompetitors(COMPETE_MANIFEST, 2);
+  const size_t match_cnt = matches.size() / 2;
+  std::cout << "Loaded " << match_cnt << " matches between " << competitor_cache.size() << " competitors." << std::endl;
+
+  std::ofstream output_fstream;
+  OpenCompeteOutput(output_fstream);
+
+  const bool parallel = std::min(eval_workers.size(), match_cnt) > 1;
+  std::mutex output_mutex;
+  RunEvalWorkers(match_cnt, [this, &matches, &output_fstream, &output_mutex, parallel](EvalWorker &worker, size_t match_id) {
+    Competitor &player_1 = *matches[2 * match_id];
+    Competitor &player_2 = *matches[2 * match_id + 1];
+    MatchResult result = PlayCompeteMatch(worker, match_id, player_1, player_2, parallel);
+
+    std::lock_guard<std::mutex> lock(output_mutex);
+    WriteMatchResult(output_fstream, match_id, player_1, player_2, result);
+  });
+  std::cout << "Played " << match_cnt << " matches. Results written to " << COMPETE_OUTPUT << std::endl;
+}
+
+/// Rate every competitor listed in COMPETE_RATING_POOL (one per line) with Glicko-1. Each round
+/// pairs competitors to shrink the rating deviations the most and plays the games in parallel,
+/// until every deviation is below COMPETE_RATING_RD or COMPETE_RATING_GAMES games were played.
+/// Games go to COMPETE_OUTPUT and final ratings to COMPETE_RATING_OUTPUT.
+void EnsembleExp::CompeteRating()
+{
+  ConfigInstKnockout(INST_KO);
+
+  emp::vector<emp::Ptr<Competitor>> pool = ReadCompetitors(COMPETE_RATING_POOL, 1);
+  if (pool.size() < 2)
+  {
+    std::cout << "Rating needs at least two competitors in " << COMPETE_RATING_POOL << ". Exiting..." << std::endl;
+    exit(-1);
   }
+  std::cout << "Rating " << pool.size() << " competitors." << std::endl;
 
-  for (auto dreamware : all_dreamware)
+  std::ofstream output_fstream;
+  OpenCompeteOutput(output_fstream);
+
+  GlickoRating ratings(pool.size());
+  const bool parallel = eval_workers.size() > 1;
+  std::mutex output_mutex;
+  size_t game_cnt = 0;
+  for (size_t round = 1; game_cnt < COMPETE_RATING_GAMES && ratings.GetMaxDeviation() >= COMPETE_RATING_RD; ++round)
   {
-    dreamware->SetPlayerID((start_player == 0) ? othello_t::DARK : othello_t::LIGHT);
+    emp::vector<std::pair<size_t, size_t>> pairings = ratings.GetPairings(COMPETE_RATING_RD);
+    pairings.resize(std::min(pairings.size(), COMPETE_RATING_GAMES - game_cnt));
+    if (pairings.empty()) break;
+
+    emp::vector<MatchResult> results(pairings.size());
+    RunEvalWorkers(pairings.size(), [this, &pool, &pairings, &results, &output_fstream, &output_mutex, game_cnt, parallel](EvalWorker &worker, size_t i) {
+      Competitor &player_1 = *pool[pairings[i].first];
+      Competitor &player_2 = *pool[pairings[i].second];
+      results[i] = PlayCompeteMatch(worker, game_cnt + i, player_1, player_2, parallel);
+
+      std::lock_guard<std::mutex> lock(output_mutex);
+      WriteMatchResult(output_fstream, game_cnt + i, player_1, player_2, results[i]);
+    });
+
+    for (size_t i = 0; i < pairings.size(); ++i)
+    {
+      ratings.AddResult(pairings[i].first, pairings[i].second, results[i].GetPoints());
+    }
+    ratings.EndPeriod();
+    game_cnt += pairings.size();
+    std::cout << "Rating round " << round << ": " << game_cnt << " games, max deviation " << ratings.GetMaxDeviation() << std::endl;
   }
 
-  // Main game loop
-  for (size_t round_num = 0; round_num < OTHELLO_MAX_ROUND_CNT; ++round_num)
+  std::ofstream rating_fstream(COMPETE_RATING_OUTPUT);
+  if (!rating_fstream.is_open())
+  {
+    std::cout << "Failed to open rating output file (" << COMPETE_RATING_OUTPUT << "). Exiting..." << std::endl;
+    exit(-1);
+  }
+  emp::vector<size_t> order(pool.size());
+  for (size_t id = 0; id < order.size(); ++id) order[id] = id;
+  std::stable_sort(order.begin(), order.end(), [&ratings](size_t a, size_t b) {
+    return ratings.Get(a).rating > ratings.Get(b).rating;
+  });
+  rating_fstream << "rank,type,path,rating,deviation,games" << std::endl;
+  for (size_t rank = 0; rank < order.size(); ++rank)
   {
+    const Competitor &competitor = *pool[order[rank]];
+    const GlickoRating::Player &player = ratings.Get(order[rank]);
+    rating_fstream << rank + 1 << "," << COMPETITOR_NAMES[competitor.type] << "," << competitor.path << ","
+                   << player.rating << "," << player.deviation << "," << player.games << std::endl;
+  }
+  std::cout << "Played " << game_cnt << " games. Ratings written to " << COMPETE_RATING_OUTPUT << std::endl;
+}
 
-    othello_idx_t move = (curr_player == 0) ? EvalMoveGroup(our_hero) : EvalMoveAI(&ai_game);
-    //std::cout<<"Player "<<curr_player<<" MOVE: "<<move.pos<<" XY: "<<move.x()<<" "<<move.y()<<std::endl;
+/// Stay running and answer match requests (see ServeCompeteRequest), one per line, so that
+/// programs are only loaded once and each request only costs its game. With COMPETE_SERVER
+/// set to '-', requests come from stdin and replies go to stdout after a "ready" line (all
+/// other output moves to stderr). Otherwise COMPETE_SERVER is a unix socket to listen on;
+/// clients are served one at a time. A "quit" request stops the server.
+void EnsembleExp::CompeteServer()
+{
+  ConfigInstKnockout(INST_KO);
+  size_t game_cnt = 0;
+  std::string request, reply;
 
-    //If a invalid move is given, fitness becomes rounds completed w/o error
-    if (!game_hw->IsValidMove(game_hw->GetCurPlayer(), move))
+  if (COMPETE_SERVER == "-")
+  {
+    std::ostream reply_stream(std::cout.rdbuf());
+    std::streambuf *cout_buf = std::cout.rdbuf(std::cerr.rdbuf());
+    reply_stream << "ready" << std::endl;
+    while (std::getline(std::cin, request) && ServeCompeteRequest(request, game_cnt, reply))
     {
-      (curr_player == 0) ? p2_wins++ : p1_wins++;
-      invalid = true;
-      //std::cout<<"INVALID: "<<move.pos<<std::endl;
-      break;
+      if (reply != "") reply_stream << reply << std::endl;
     }
+    std::cout.rdbuf(cout_buf);
+    return;
+  }
 
-    bool go_again = game_hw->DoNextMove(move);
-    ai_game.board.ApplyMove(ConvertToMoveAI(&ai_game, move));
-    //std::cout<<"go again: "<<go_again<<std::endl;
-    //ai_game.board.Print();
-    if (game_hw->IsOver())
-      break;
-    if (!go_again)
+  const char *socket_path = COMPETE_SERVER.c_str();
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (COMPETE_SERVER.size() >= sizeof(addr.sun_path))
+  {
+    std::cout << "Compete socket path is too long (" << COMPETE_SERVER << "). Exiting..." << std::endl;
+    exit(-1);
+  }
+  std::strcpy(addr.sun_path, socket_path);
+
+  // Replace a socket left behind by an earlier server, but never any other kind of file.
+  struct stat socket_stat;
+  if (stat(socket_path, &socket_stat) == 0 && S_ISSOCK(socket_stat.st_mode)) unlink(socket_path);
+
+  const int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server_fd < 0 || bind(server_fd, (sockaddr *)&addr, sizeof(addr)) < 0 || listen(server_fd, 16) < 0)
+  {
+    std::cout << "Failed to listen on compete socket (" << COMPETE_SERVER << "): " << std::strerror(errno) << ". Exiting..." << std::endl;
+    exit(-1);
+  }
+  std::cout << "Serving compete requests on " << COMPETE_SERVER << std::endl;
+
+  bool serving = true;
+  while (serving)
+  {
+    const int client_fd = accept(server_fd, nullptr, nullptr);
+    if (client_fd < 0)
     {
-      curr_player = !curr_player; //Change current player if you don't get another turn
-      ai_game.board.NextPlayer(false);
+      if (errno == EINTR) continue;
+      std::cout << "Failed to accept compete client: " << std::strerror(errno) << ". Exiting..." << std::endl;
+      exit(-1);
     }
-    // game_hw->Print();
-    // std::cout<<"DREAMWARE:"<<std::endl;
-    // othello_dreamware->GetActiveDreamOthello().Print();
+
+    std::string pending;
+    char buffer[4096];
+    bool connected = true;
+    while (serving && connected)
+    {
+      const ssize_t read_cnt = read(client_fd, buffer, sizeof(buffer));
+      if (read_cnt < 0 && errno == EINTR) continue;
+      if (read_cnt <= 0) break;
+      pending.append(buffer, read_cnt);
+
+      size_t newline;
+      while (serving && connected && (newline = pending.find('\n')) != std::string::npos)
+      {
+        request = pending.substr(0, newline);
+        pending.erase(0, newline + 1);
+        serving = ServeCompeteRequest(request, game_cnt, reply);
+        if (reply == "") continue;
+
+        // A client that hangs up early only loses its own replies.
+        reply += '\n';
+        for (size_t sent = 0; connected && sent < reply.size(); )
+        {
+          const ssize_t sent_cnt = send(client_fd, reply.data() + sent, reply.size() - sent, MSG_NOSIGNAL);
+          if (sent_cnt < 0 && errno == EINTR) continue;
+          connected = (sent_cnt > 0);
+          if (connected) sent += sent_cnt;
+        }
+      }
+    }
+    close(client_fd);
   }
-  double hero_score = game_hw->GetScore((start_player == 0) ? dark : light);
-  double opp_score = game_hw->GetScore((start_player == 1) ? dark : light);
+  close(server_fd);
+  unlink(socket_path);
+  std::cout << "Played " << game_cnt << " requested games." << std::endl;
+}
 
-  std::cout<<hero_score<<" "<<opp_score<<" "<<invalid<< " "<<curr_player<<" "<<start_player<<std::endl;
+/// Answer one compete server request: two competitors as in COMPETE_MANIFEST, then any of
+///   seed=<n>      play the game batch mode plays as match n (default: games played so far)
+///   agent_ko=<n>  knock agent n out of ensembles (default AGENT_KO, negative for none)
+///   inst_ko=<n>   instruction knockout, as INST_KO (default INST_KO)
+/// The reply is "<score_1> <score_2> <invalid> <curr_player> <start_player>" (as Compete
+/// prints it) or "error <reason>". Blank requests get no reply.
+/// returns: false if the request asks the server to quit
+bool EnsembleExp::ServeCompeteRequest(const std::string &request, size_t &game_cnt, std::string &reply)
+{
+  reply = "";
+  std::stringstream ss(request.substr(0, request.find('#')));
+  emp::vector<std::string> fields;
+  std::string field;
+  while (ss >> field) fields.push_back(field);
+  if (fields.empty()) return true;
+  if (fields.size() == 1 && fields[0] == "quit") return false;
+
+  size_t pos = 0;
+  emp::array<size_t, 2> types;
+  emp::array<std::string, 2> paths;
+  for (size_t p = 0; p < 2; ++p)
+  {
+    if (!ParseCompetitor(fields, pos, types[p], paths[p]))
+    {
+      reply = "error expected two competitors ('ai', 'individual <path>' or 'ensemble <path>')";
+      return true;
+    }
+    if (paths[p] != "" && !std::ifstream(paths[p]).is_open())
+    {
+      reply = "error cannot open " + paths[p];
+      return true;
+    }
+  }
+
+  size_t seed = game_cnt;
+  long long agent_ko = AGENT_KO;
+  long long inst_ko = INST_KO;
+  for (; pos < fields.size(); ++pos)
+  {
+    const size_t split = fields[pos].find('=');
+    const std::string key = fields[pos].substr(0, split);
+    long long value = 0;
+    std::stringstream value_ss(split == std::string::npos ? "" : fields[pos].substr(split + 1));
+    if (!(value_ss >> value) || !value_ss.eof())
+    {
+      reply = "error bad option " + fields[pos];
+      return true;
+    }
+
+    if (key == "seed" && value >= 0) seed = (size_t)value;
+    else if (key == "agent_ko" && value < (long long)GROUP_SIZE) agent_ko = value;
+    else if (key == "inst_ko" && value >= (long long)INST_KO_NONE && value <= (long long)INST_KO_COMM) inst_ko = value;
+    else
+    {
+      reply = "error bad option " + fields[pos];
+      return true;
+    }
+  }
+
+  if ((size_t)inst_ko != inst_ko_applied) ConfigInstKnockout(inst_ko);
+  Competitor &player_1 = *GetCompetitor(types[0], paths[0], (int)agent_ko);
+  Competitor &player_2 = *GetCompetitor(types[1], paths[1], (int)agent_ko);
+  MatchResult result = PlayCompeteMatch(*eval_workers[0], seed, player_1, player_2, false);
+  ++game_cnt;
+
+  std::stringstream reply_ss;
+  reply_ss << result.score_1 << " " << result.score_2 << " " << result.invalid << " "
+           << result.curr_player << " " << result.start_player;
+  reply = reply_ss.str();
+  return true;
+}
+
+/// Play COMPETE_KO_GAMES games against the Minimax AI with every knockout of the ANCESTOR_FPATH
+/// program(s): each agent knockout (or none) combined with each instruction knockout (or none).
+/// Every variant plays the same games (same starting player and random streams), so they can be
+/// compared game by game. All variants play at once: each instruction knockout runs on its own
+/// copy of the instruction libraries and hardware. Writes one CSV row per variant to COMPETE_KO_MATRIX.
+void EnsembleExp::CompeteKnockoutMatrix()
+{
+  const size_t type = (REPRESENTATION == REPRESENTATION_ID__SIGNALGP) ? COMPETITOR_ID__INDIVIDUAL : COMPETITOR_ID__ENSEMBLE;
+  const size_t agent_ko_cnt = (type == COMPETITOR_ID__ENSEMBLE) ? GROUP_SIZE + 1 : 1; // First is no agent knockout.
+  const size_t inst_ko_cnt = sizeof(INST_KO_NAMES) / sizeof(INST_KO_NAMES[0]);
+
+  emp::vector<emp::Ptr<Competitor>> variants(agent_ko_cnt);
+  for (size_t a = 0; a < agent_ko_cnt; ++a) variants[a] = GetCompetitor(type, ANCESTOR_FPATH, (int)a - 1);
+  Competitor &ai = *GetCompetitor(COMPETITOR_ID__AI, "", -1);
+
+  emp::vector<emp::vector<emp::Ptr<EvalWorker>>> ko_workers(inst_ko_cnt);
+  emp::vector<emp::Ptr<SGP__inst_lib_t>> ko_libs;
+  const size_t context_cnt = eval_contexts.size(); // Knockout workers add their contexts after these.
+  for (size_t inst_ko = 0; inst_ko < inst_ko_cnt; ++inst_ko)
+  {
+    emp::Ptr<SGP__inst_lib_t> ko_lib = KnockoutInstLib(sgp_inst_lib, inst_ko);
+    emp::Ptr<SGP__inst_lib_t> ko_coord_lib = KnockoutInstLib(coord_inst_lib, inst_ko);
+    if (ko_lib != sgp_inst_lib) ko_libs.push_back(ko_lib);
+    if (ko_coord_lib != coord_inst_lib) ko_libs.push_back(ko_coord_lib);
+    if (inst_ko == INST_KO_NONE)
+    {
+      ko_workers[inst_ko] = eval_workers;
+      continue;
+    }
+    for (auto worker : eval_workers)
+    {
+      ko_workers[inst_ko].push_back(NewEvalWorker(worker->id, ko_lib, ko_coord_lib));
+      ko_workers[inst_ko].back()->coordinator_id = worker->coordinator_id;
+    }
+  }
+
+  const size_t variant_cnt = inst_ko_cnt * agent_ko_cnt;
+  std::cout << "Playing " << COMPETE_KO_GAMES << " games with each of " << variant_cnt << " knockouts of "
+            << ANCESTOR_FPATH << "." << std::endl;
+  emp::vector<MatchResult> results(variant_cnt * COMPETE_KO_GAMES);
+  const bool parallel = std::min(eval_workers.size(), results.size()) > 1;
+  RunEvalWorkers(results.size(), [this, &variants, &ai, &ko_workers, &results, agent_ko_cnt, parallel](EvalWorker &worker, size_t i) {
+    const size_t variant = i / COMPETE_KO_GAMES;
+    EvalWorker &ko_worker = *ko_workers[variant / agent_ko_cnt][worker.id];
+    results[i] = PlayCompeteMatch(ko_worker, i % COMPETE_KO_GAMES, *variants[variant % agent_ko_cnt], ai, parallel);
+  });
+
+  std::ofstream matrix_fstream(COMPETE_KO_MATRIX);
+  if (!matrix_fstream.is_open())
+  {
+    std::cout << "Failed to open knockout matrix file (" << COMPETE_KO_MATRIX << "). Exiting..." << std::endl;
+    exit(-1);
+  }
+  matrix_fstream << "agent_ko,inst_ko,games,wins,losses,ties,invalid,win_rate,average_score" << std::endl;
+  for (size_t variant = 0; variant < variant_cnt; ++variant)
+  {
+    MatchTally tally;
+    for (size_t game = 0; game < COMPETE_KO_GAMES; ++game) tally.Add(results[variant * COMPETE_KO_GAMES + game]);
+    const double games = (double)std::max(COMPETE_KO_GAMES, (size_t)1);
+    matrix_fstream << (int)(variant % agent_ko_cnt) - 1 << "," << variant / agent_ko_cnt << "," << COMPETE_KO_GAMES << ","
+                   << tally.wins << "," << tally.losses << "," << tally.ties << "," << tally.invalid << ","
+                   << tally.wins / games << "," << tally.total_score / games << std::endl;
+  }
+  std::cout << "Played " << results.size() << " games. Knockout matrix written to " << COMPETE_KO_MATRIX << std::endl;
+
+  for (size_t inst_ko = 1; inst_ko < inst_ko_cnt; ++inst_ko)
+  {
+    for (auto worker : ko_workers[inst_ko]) DeleteEvalWorker(worker);
+  }
+  eval_contexts.resize(context_cnt);
+  for (auto ko_lib : ko_libs) ko_lib.Delete();
 }
 
 #endif
\ No newline at end of file